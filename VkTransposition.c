@@ -0,0 +1,3014 @@
+﻿#ifdef __cplusplus
+extern "C" {
+#endif
+#include "VkTransposition.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VK_APP_X86 1
+#include <immintrin.h>
+#endif
+
+#ifdef NDEBUG
+	const VkBool32 enableValidationLayers = 0;
+#else
+	const VkBool32 enableValidationLayers = 1;
+#endif
+const VkAppDataType dataTypes[VK_APP_NUM_DATA_TYPES] = {
+	{ "fp32", "", 4 },
+	{ "fp16", "_16bit", 2 },
+	{ "fp64", "_64bit", 8 },
+	{ "int8", "_8bit", 1 },
+	{ "complex_fp32", "_64bit", 8 },
+	{ "complex_fp64", "_128bit", 16 },
+};
+
+uint32_t* VkFFTReadShader(uint32_t* length, const char* filename) {
+	//function that reads shader's SPIR - V bytecode
+	FILE* fp = fopen(filename, "rb");
+	if (fp == NULL) {
+		printf("Could not find or open file: %s\n", filename);
+	}
+
+	// get file size.
+	fseek(fp, 0, SEEK_END);
+	long filesize = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	long filesizepadded = ((long)ceil(filesize / 4.0)) * 4;
+
+	char* str = (char*)malloc(sizeof(char) * filesizepadded);
+	fread(str, filesize, sizeof(char), fp);
+	fclose(fp);
+
+	for (long i = filesize; i < filesizepadded; i++) {
+		str[i] = 0;
+	}
+
+	length[0] = filesizepadded;
+	return (uint32_t*)str;
+}
+VkResult CreateDebugUtilsMessengerEXT(VkGPU* vkGPU, const VkDebugUtilsMessengerCreateInfoEXT* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkDebugUtilsMessengerEXT* pDebugMessenger) {
+	//pointer to the function, as it is not part of the core. Function creates debugging messenger
+	PFN_vkCreateDebugUtilsMessengerEXT func = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(vkGPU->instance, "vkCreateDebugUtilsMessengerEXT");
+	if (func != NULL) {
+		return func(vkGPU->instance, pCreateInfo, pAllocator, pDebugMessenger);
+	}
+	else {
+		return VK_ERROR_EXTENSION_NOT_PRESENT;
+	}
+}
+void DestroyDebugUtilsMessengerEXT(VkGPU* vkGPU, const VkAllocationCallbacks* pAllocator) {
+	//pointer to the function, as it is not part of the core. Function destroys debugging messenger
+	PFN_vkDestroyDebugUtilsMessengerEXT func = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(vkGPU->instance, "vkDestroyDebugUtilsMessengerEXT");
+	if (func != NULL) {
+		func(vkGPU->instance, vkGPU->debugMessenger, pAllocator);
+	}
+}
+static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, VkDebugUtilsMessageTypeFlagsEXT messageType, const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, void* pUserData) {
+	printf("validation layer: %s\n", pCallbackData->pMessage);
+	return VK_FALSE;
+}
+VkResult setupDebugMessenger(VkGPU* vkGPU) {
+	//function that sets up the debugging messenger 
+	if (enableValidationLayers == 0) return VK_SUCCESS;
+
+	VkDebugUtilsMessengerCreateInfoEXT createInfo = { VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT };
+	createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+	createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+	createInfo.pfnUserCallback = debugCallback;
+
+	if (CreateDebugUtilsMessengerEXT(vkGPU, &createInfo, NULL, &vkGPU->debugMessenger) != VK_SUCCESS) {
+		return VK_ERROR_INITIALIZATION_FAILED;
+	}
+	return VK_SUCCESS;
+}
+VkResult checkValidationLayerSupport() {
+	//check if validation layers are supported when an instance is created
+	uint32_t layerCount;
+	vkEnumerateInstanceLayerProperties(&layerCount, NULL);
+
+	VkLayerProperties* availableLayers = (VkLayerProperties*)malloc(sizeof(VkLayerProperties) * layerCount);
+	vkEnumerateInstanceLayerProperties(&layerCount, availableLayers);
+
+	for (uint32_t i = 0; i < layerCount; i++) {
+		if (strcmp("VK_LAYER_KHRONOS_validation", availableLayers[i].layerName) == 0) {
+			free(availableLayers);
+			return VK_SUCCESS;
+		}
+	}
+	free(availableLayers);
+	return VK_ERROR_LAYER_NOT_PRESENT;
+}
+VkResult createInstance(VkGPU* vkGPU) {
+	//create instance - a connection between the application and the Vulkan library 
+	VkResult res = VK_SUCCESS;
+	//check if validation layers are supported
+	if (enableValidationLayers == 1) {
+		res = checkValidationLayerSupport();
+		if (res != VK_SUCCESS) return res;
+	}
+	//sample app information
+	VkApplicationInfo applicationInfo = { VK_STRUCTURE_TYPE_APPLICATION_INFO };
+	applicationInfo.pApplicationName = "VulkanTest";
+	applicationInfo.applicationVersion = 1.0;
+	applicationInfo.pEngineName = "VulkanTest";
+	applicationInfo.engineVersion = 1.0;
+	//Vulkan 1.1 is requested if the loader supports it. 1.0 loaders have no vkEnumerateInstanceVersion and reject instances of higher versions, so they get a 1.0 instance without the 8/16-bit and subgroup paths
+	uint32_t instanceVersion = VK_API_VERSION_1_0;
+	PFN_vkEnumerateInstanceVersion enumerateInstanceVersion = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceVersion");
+	if ((enumerateInstanceVersion == NULL) || (enumerateInstanceVersion(&instanceVersion) != VK_SUCCESS)) instanceVersion = VK_API_VERSION_1_0;
+	applicationInfo.apiVersion = (instanceVersion >= VK_API_VERSION_1_1) ? VK_API_VERSION_1_1 : VK_API_VERSION_1_0;
+
+	VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+	createInfo.flags = 0;
+	createInfo.pApplicationInfo = &applicationInfo;
+	//specify, whether debugging utils are required
+	if (enableValidationLayers == 1) {
+		const char* const extensions = { VK_EXT_DEBUG_UTILS_EXTENSION_NAME };
+		createInfo.enabledExtensionCount = 1;
+		createInfo.ppEnabledExtensionNames = &extensions;
+	}
+	else {
+		createInfo.enabledExtensionCount = 0;
+		createInfo.ppEnabledExtensionNames = NULL;
+	}
+	VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo = { VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT };
+	if (enableValidationLayers == 1) {
+		//query for the validation layer support in the instance
+		createInfo.enabledLayerCount = 1;
+		const char* validationLayers = "VK_LAYER_KHRONOS_validation";
+		createInfo.ppEnabledLayerNames = &validationLayers;
+		debugCreateInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+		debugCreateInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+		debugCreateInfo.pfnUserCallback = debugCallback;
+		createInfo.pNext = (VkDebugUtilsMessengerCreateInfoEXT*)&debugCreateInfo;
+	}
+	else {
+		createInfo.enabledLayerCount = 0;
+		createInfo.pNext = NULL;
+	}
+	//create instance
+	res = vkCreateInstance(&createInfo, NULL, &vkGPU->instance);
+	if (res != VK_SUCCESS) return res;
+	//1.1 entry points are loaded at run time, so the library also starts with loaders that do not export them
+	vkGPU->apiVersion = applicationInfo.apiVersion;
+	if (vkGPU->apiVersion >= VK_API_VERSION_1_1) {
+		vkGPU->getPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)vkGetInstanceProcAddr(vkGPU->instance, "vkGetPhysicalDeviceFeatures2");
+		vkGPU->getPhysicalDeviceProperties2 = (PFN_vkGetPhysicalDeviceProperties2)vkGetInstanceProcAddr(vkGPU->instance, "vkGetPhysicalDeviceProperties2");
+		if ((vkGPU->getPhysicalDeviceFeatures2 == NULL) || (vkGPU->getPhysicalDeviceProperties2 == NULL)) vkGPU->apiVersion = VK_API_VERSION_1_0;
+	}
+	return res;
+}
+VkResult findPhysicalDevice(VkGPU* vkGPU) {
+	//check if there are GPUs that support Vulkan and select one
+	VkResult res = VK_SUCCESS;
+	uint32_t deviceCount;
+	res = vkEnumeratePhysicalDevices(vkGPU->instance, &deviceCount, NULL);
+	if (res != VK_SUCCESS) return res;
+	if (deviceCount == 0) {
+		return VK_ERROR_DEVICE_LOST;
+	}
+
+	VkPhysicalDevice* devices = (VkPhysicalDevice*)malloc(sizeof(VkPhysicalDevice) * deviceCount);
+	res = vkEnumeratePhysicalDevices(vkGPU->instance, &deviceCount, devices);
+	if ((res != VK_SUCCESS) || (vkGPU->device_id >= deviceCount)) {
+		free(devices);
+		return (res != VK_SUCCESS) ? res : VK_ERROR_DEVICE_LOST;
+	}
+	vkGPU->physicalDevice = devices[vkGPU->device_id];
+	free(devices);
+	return VK_SUCCESS;
+}
+VkResult getComputeQueueFamilyIndex(VkGPU* vkGPU) {
+	//find a queue family for a selected GPU, select the first available for use. Transfers use a family that only supports transfers if there is one: it is served by the copy engines and runs in parallel with compute
+	uint32_t queueFamilyCount;
+	vkGetPhysicalDeviceQueueFamilyProperties(vkGPU->physicalDevice, &queueFamilyCount, NULL);
+
+	VkQueueFamilyProperties* queueFamilies = (VkQueueFamilyProperties*)malloc(sizeof(VkQueueFamilyProperties) * queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(vkGPU->physicalDevice, &queueFamilyCount, queueFamilies);
+	uint32_t i = 0;
+	for (; i < queueFamilyCount; i++) {
+		VkQueueFamilyProperties props = queueFamilies[i];
+
+		if (props.queueCount > 0 && (props.queueFlags & VK_QUEUE_COMPUTE_BIT)) {
+			break;
+		}
+	}
+	if (i == queueFamilyCount) {
+		free(queueFamilies);
+		return VK_ERROR_INITIALIZATION_FAILED;
+	}
+	vkGPU->queueFamilyIndex = i;
+	vkGPU->timestampValidBits = queueFamilies[i].timestampValidBits;
+	vkGPU->transferQueueFamilyIndex = i;
+	for (uint32_t j = 0; j < queueFamilyCount; j++) {
+		if ((queueFamilies[j].queueCount > 0) && (queueFamilies[j].queueFlags & VK_QUEUE_TRANSFER_BIT) && (!(queueFamilies[j].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))) {
+			vkGPU->transferQueueFamilyIndex = j;
+			break;
+		}
+	}
+	//compute queues of the selected family go first, then the queues of the other compute families (devices often have a graphics family with one queue and a compute-only family with several)
+	vkGPU->numComputeQueues = 0;
+	vkGPU->numQueueFamilies = 0;
+	for (uint32_t j = 0; j < queueFamilyCount; j++) {
+		uint32_t family = (j == 0) ? i : ((j <= i) ? j - 1 : j);
+		if ((queueFamilies[family].queueCount == 0) || (!(queueFamilies[family].queueFlags & VK_QUEUE_COMPUTE_BIT)) || (vkGPU->numComputeQueues == VK_APP_MAX_QUEUES)) continue;
+		for (uint32_t k = 0; (k < queueFamilies[family].queueCount) && (vkGPU->numComputeQueues < VK_APP_MAX_QUEUES); k++) {
+			vkGPU->computeQueueFamilies[vkGPU->numComputeQueues] = family;
+			vkGPU->numComputeQueues++;
+		}
+		vkGPU->queueFamilies[vkGPU->numQueueFamilies] = family;
+		vkGPU->numQueueFamilies++;
+	}
+	if (vkGPU->transferQueueFamilyIndex != i) {
+		vkGPU->queueFamilies[vkGPU->numQueueFamilies] = vkGPU->transferQueueFamilyIndex;
+		vkGPU->numQueueFamilies++;
+	}
+	free(queueFamilies);
+	return VK_SUCCESS;
+}
+VkResult createDevice(VkGPU* vkGPU) {
+	//create logical device representation
+	VkResult res = VK_SUCCESS;
+	VkDeviceQueueCreateInfo queueCreateInfo[VK_APP_MAX_QUEUES + 1];
+	res = getComputeQueueFamilyIndex(vkGPU);
+	if (res != VK_SUCCESS) return res;
+	float queuePriorities[VK_APP_MAX_QUEUES];
+	for (uint32_t i = 0; i < VK_APP_MAX_QUEUES; i++)
+		queuePriorities[i] = 1.0;
+	//one create info per family: all listed queues of a compute family, or the one queue of the dedicated transfer family
+	for (uint32_t i = 0; i < vkGPU->numQueueFamilies; i++) {
+		VkDeviceQueueCreateInfo familyCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+		familyCreateInfo.queueFamilyIndex = vkGPU->queueFamilies[i];
+		familyCreateInfo.queueCount = 0;
+		for (uint32_t j = 0; j < vkGPU->numComputeQueues; j++) {
+			if (vkGPU->computeQueueFamilies[j] == vkGPU->queueFamilies[i]) familyCreateInfo.queueCount++;
+		}
+		if (familyCreateInfo.queueCount == 0) familyCreateInfo.queueCount = 1;
+		familyCreateInfo.pQueuePriorities = queuePriorities;
+		queueCreateInfo[i] = familyCreateInfo;
+	}
+	VkDeviceCreateInfo deviceCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+	deviceCreateInfo.enabledExtensionCount = 0;
+	deviceCreateInfo.ppEnabledExtensionNames = NULL;
+	deviceCreateInfo.pQueueCreateInfos = queueCreateInfo;
+	deviceCreateInfo.queueCreateInfoCount = vkGPU->numQueueFamilies;
+	//8-bit storage is an extension, 16-bit storage is core since Vulkan 1.1. Import of host allocations needs VK_EXT_external_memory_host, that depends on external memory from Vulkan 1.1
+	const char* storage8BitExtension = VK_KHR_8BIT_STORAGE_EXTENSION_NAME;
+	const char* externalMemoryHostExtension = VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME;
+	const char* enabledExtensions[2];
+	uint32_t numEnabledExtensions = 0;
+	uint32_t has8BitExtension = 0;
+	uint32_t hasExternalMemoryHostExtension = 0;
+	uint32_t extensionCount = 0;
+	res = vkEnumerateDeviceExtensionProperties(vkGPU->physicalDevice, NULL, &extensionCount, NULL);
+	if (res != VK_SUCCESS) return res;
+	VkExtensionProperties* extensions = (VkExtensionProperties*)malloc(sizeof(VkExtensionProperties) * extensionCount);
+	res = vkEnumerateDeviceExtensionProperties(vkGPU->physicalDevice, NULL, &extensionCount, extensions);
+	if (res != VK_SUCCESS) {
+		free(extensions);
+		return res;
+	}
+	for (uint32_t i = 0; i < extensionCount; i++) {
+		if (strcmp(extensions[i].extensionName, storage8BitExtension) == 0) has8BitExtension = 1;
+		if (strcmp(extensions[i].extensionName, externalMemoryHostExtension) == 0) hasExternalMemoryHostExtension = 1;
+	}
+	free(extensions);
+	//query supported features and enable only the ones used by the shaders. Double precision support is kept from the original sample, but it is not required: elements are moved bit-exact
+	VkPhysicalDeviceFeatures2 deviceFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+	VkPhysicalDevice16BitStorageFeatures storage16BitFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES };
+	VkPhysicalDevice8BitStorageFeaturesKHR storage8BitFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_8BIT_STORAGE_FEATURES_KHR };
+	VkPhysicalDeviceFeatures2 enabledFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+	VkPhysicalDevice16BitStorageFeatures enabled16BitFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES };
+	VkPhysicalDevice8BitStorageFeaturesKHR enabled8BitFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_8BIT_STORAGE_FEATURES_KHR };
+	if (vkGPU->apiVersion >= VK_API_VERSION_1_1) {
+		deviceFeatures.pNext = &storage16BitFeatures;
+		if (has8BitExtension) storage16BitFeatures.pNext = &storage8BitFeatures;
+		vkGPU->getPhysicalDeviceFeatures2(vkGPU->physicalDevice, &deviceFeatures);
+		vkGPU->storage16Bit = storage16BitFeatures.storageBuffer16BitAccess;
+		vkGPU->storage8Bit = has8BitExtension && storage8BitFeatures.storageBuffer8BitAccess;
+		enabledFeatures.features.shaderFloat64 = deviceFeatures.features.shaderFloat64;
+		enabled16BitFeatures.storageBuffer16BitAccess = vkGPU->storage16Bit;
+		enabled8BitFeatures.storageBuffer8BitAccess = vkGPU->storage8Bit;
+		enabledFeatures.pNext = &enabled16BitFeatures;
+		if (vkGPU->storage8Bit) {
+			enabled16BitFeatures.pNext = &enabled8BitFeatures;
+			enabledExtensions[numEnabledExtensions] = storage8BitExtension;
+			numEnabledExtensions++;
+		}
+		if (hasExternalMemoryHostExtension) {
+			VkPhysicalDeviceProperties2 deviceProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+			VkPhysicalDeviceExternalMemoryHostPropertiesEXT externalMemoryHostProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT };
+			deviceProperties.pNext = &externalMemoryHostProperties;
+			vkGPU->getPhysicalDeviceProperties2(vkGPU->physicalDevice, &deviceProperties);
+			vkGPU->minImportedHostPointerAlignment = externalMemoryHostProperties.minImportedHostPointerAlignment;
+			vkGPU->externalMemoryHost = 1;
+			enabledExtensions[numEnabledExtensions] = externalMemoryHostExtension;
+			numEnabledExtensions++;
+		}
+		deviceCreateInfo.enabledExtensionCount = numEnabledExtensions;
+		deviceCreateInfo.ppEnabledExtensionNames = (numEnabledExtensions) ? enabledExtensions : NULL;
+		deviceCreateInfo.pNext = &enabledFeatures;
+		deviceCreateInfo.pEnabledFeatures = NULL;
+	}
+	else {
+		//Vulkan 1.0 devices and loaders only support 32-bit and larger element types
+		vkGetPhysicalDeviceFeatures(vkGPU->physicalDevice, &deviceFeatures.features);
+		enabledFeatures.features.shaderFloat64 = deviceFeatures.features.shaderFloat64;
+		deviceCreateInfo.pEnabledFeatures = &enabledFeatures.features;
+	}
+	res = vkCreateDevice(vkGPU->physicalDevice, &deviceCreateInfo, NULL, &vkGPU->device);
+	if (res != VK_SUCCESS) return res;
+	vkGetDeviceQueue(vkGPU->device, vkGPU->queueFamilyIndex, 0, &vkGPU->queue);
+	vkGetDeviceQueue(vkGPU->device, vkGPU->transferQueueFamilyIndex, 0, &vkGPU->transferQueue);
+	for (uint32_t i = 0; i < vkGPU->numComputeQueues; i++) {
+		//index of the queue in its family
+		uint32_t queueIndex = 0;
+		for (uint32_t j = 0; j < i; j++) {
+			if (vkGPU->computeQueueFamilies[j] == vkGPU->computeQueueFamilies[i]) queueIndex++;
+		}
+		vkGetDeviceQueue(vkGPU->device, vkGPU->computeQueueFamilies[i], queueIndex, &vkGPU->computeQueues[i]);
+	}
+	if (vkGPU->externalMemoryHost) {
+		vkGPU->getMemoryHostPointerProperties = (PFN_vkGetMemoryHostPointerPropertiesEXT)vkGetDeviceProcAddr(vkGPU->device, "vkGetMemoryHostPointerPropertiesEXT");
+		if (vkGPU->getMemoryHostPointerProperties == NULL) vkGPU->externalMemoryHost = 0;
+	}
+	return res;
+}
+VkResult createFence(VkGPU* vkGPU) {
+	//create fence for synchronization 
+	VkResult res = VK_SUCCESS;
+	VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+	fenceCreateInfo.flags = 0;
+	res = vkCreateFence(vkGPU->device, &fenceCreateInfo, NULL, &vkGPU->fence);
+	return res;
+}
+typedef struct {
+	uint32_t magic;//VK_APP_PIPELINE_CACHE_MAGIC
+	uint32_t dataSize;//size of the pipeline cache data following the header
+	uint32_t vendorID;
+	uint32_t deviceID;
+	uint32_t driverVersion;
+	uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+} VkAppPipelineCacheFileHeader;//header of the pipeline cache file. The data is only reused on the same device with the same driver
+#define VK_APP_PIPELINE_CACHE_MAGIC 0x5054564B
+VkResult createPipelineCache(VkGPU* vkGPU) {
+	//create the pipeline cache, initialized from the pipeline cache file if it was saved on the same device with the same driver. Otherwise the cache starts empty
+	VkResult res = VK_SUCCESS;
+	void* initialData = NULL;
+	vkGPU->pipelineCacheLoadedSize = 0;
+	FILE* fp = (vkGPU->pipelineCachePath) ? fopen(vkGPU->pipelineCachePath, "rb") : NULL;
+	if (fp != NULL) {
+		VkAppPipelineCacheFileHeader header = { 0 };
+		VkPhysicalDeviceProperties* properties = &vkGPU->physicalDeviceProperties;
+		if ((fread(&header, sizeof(header), 1, fp) == 1) && (header.magic == VK_APP_PIPELINE_CACHE_MAGIC) && (header.vendorID == properties->vendorID) && (header.deviceID == properties->deviceID) && (header.driverVersion == properties->driverVersion) && (memcmp(header.pipelineCacheUUID, properties->pipelineCacheUUID, VK_UUID_SIZE) == 0) && (header.dataSize > 0)) {
+			initialData = malloc(header.dataSize);
+			if (fread(initialData, header.dataSize, 1, fp) == 1) {
+				vkGPU->pipelineCacheLoadedSize = header.dataSize;
+			}
+			else {
+				free(initialData);
+				initialData = NULL;
+			}
+		}
+		fclose(fp);
+	}
+	VkPipelineCacheCreateInfo pipelineCacheCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+	pipelineCacheCreateInfo.initialDataSize = vkGPU->pipelineCacheLoadedSize;
+	pipelineCacheCreateInfo.pInitialData = initialData;
+	res = vkCreatePipelineCache(vkGPU->device, &pipelineCacheCreateInfo, NULL, &vkGPU->pipelineCache);
+	free(initialData);
+	return res;
+}
+VkResult savePipelineCache(VkGPU* vkGPU) {
+	//write the pipeline cache to the pipeline cache file. The file is written under a temporary name and renamed, so concurrent processes never read a partially written cache
+	VkResult res = VK_SUCCESS;
+	if ((vkGPU->pipelineCachePath == NULL) || (vkGPU->pipelineCache == VK_NULL_HANDLE)) return res;
+	size_t dataSize = 0;
+	res = vkGetPipelineCacheData(vkGPU->device, vkGPU->pipelineCache, &dataSize, NULL);
+	if (res != VK_SUCCESS) return res;
+	if (dataSize == 0) return res;
+	void* data = malloc(dataSize);
+	res = vkGetPipelineCacheData(vkGPU->device, vkGPU->pipelineCache, &dataSize, data);
+	if (res != VK_SUCCESS) {
+		free(data);
+		return res;
+	}
+	VkAppPipelineCacheFileHeader header = { 0 };
+	header.magic = VK_APP_PIPELINE_CACHE_MAGIC;
+	header.dataSize = (uint32_t)dataSize;
+	header.vendorID = vkGPU->physicalDeviceProperties.vendorID;
+	header.deviceID = vkGPU->physicalDeviceProperties.deviceID;
+	header.driverVersion = vkGPU->physicalDeviceProperties.driverVersion;
+	memcpy(header.pipelineCacheUUID, vkGPU->physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+	//the temporary name has the process id and the address of the VkGPU, so processes and devices that share the cache file never write the same temporary file
+	char temporaryPath[1024];
+#ifdef _WIN32
+	unsigned long processID = (unsigned long)GetCurrentProcessId();
+#else
+	unsigned long processID = (unsigned long)getpid();
+#endif
+	int pathLength = snprintf(temporaryPath, sizeof(temporaryPath), "%s.%lu.%llx.tmp", vkGPU->pipelineCachePath, processID, (unsigned long long)(uintptr_t)vkGPU);
+	if ((pathLength < 0) || (pathLength >= (int)sizeof(temporaryPath))) {
+		free(data);
+		return VK_ERROR_INITIALIZATION_FAILED;
+	}
+	FILE* fp = fopen(temporaryPath, "wb");
+	if (fp == NULL) {
+		free(data);
+		return VK_ERROR_INITIALIZATION_FAILED;
+	}
+	uint32_t written = (fwrite(&header, sizeof(header), 1, fp) == 1) && (fwrite(data, dataSize, 1, fp) == 1);
+	if (fclose(fp) != 0) written = 0;
+	free(data);
+	if (!written) {
+		remove(temporaryPath);
+		return VK_ERROR_INITIALIZATION_FAILED;
+	}
+#ifdef _WIN32
+	//rename does not replace existing files on Windows
+	remove(vkGPU->pipelineCachePath);
+#endif
+	if (rename(temporaryPath, vkGPU->pipelineCachePath) != 0) {
+		remove(temporaryPath);
+		return VK_ERROR_INITIALIZATION_FAILED;
+	}
+	return res;
+}
+VkResult createCommandPool(VkGPU* vkGPU) {
+	//create a place, command buffer memory is allocated from
+	VkResult res = VK_SUCCESS;
+	VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	commandPoolCreateInfo.queueFamilyIndex = vkGPU->queueFamilyIndex;
+	res = vkCreateCommandPool(vkGPU->device, &commandPoolCreateInfo, NULL, &vkGPU->commandPool);
+	if (res != VK_SUCCESS) return res;
+	//command buffers of the transfers are allocated from the pool of the transfer queue family
+	commandPoolCreateInfo.queueFamilyIndex = vkGPU->transferQueueFamilyIndex;
+	res = vkCreateCommandPool(vkGPU->device, &commandPoolCreateInfo, NULL, &vkGPU->transferCommandPool);
+	return res;
+}
+VkResult createStagingRing(VkGPU* vkGPU) {
+	//create the persistent staging buffer, that stays mapped, and a command buffer and a fence for each transfer in flight. They are reused by all transfers between the CPU and the GPU
+	VkResult res = VK_SUCCESS;
+	if (vkGPU->stagingBufferSize == 0) vkGPU->stagingBufferSize = 64 * 1024 * 1024;
+	res = allocateFFTBuffer(vkGPU, &vkGPU->stagingBuffer, &vkGPU->stagingBufferDeviceMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, vkGPU->stagingBufferSize);
+	if (res != VK_SUCCESS) return res;
+	res = vkMapMemory(vkGPU->device, vkGPU->stagingBufferDeviceMemory, 0, vkGPU->stagingBufferSize, 0, &vkGPU->stagingData);
+	if (res != VK_SUCCESS) return res;
+	for (uint32_t i = 0; i < VK_APP_MAX_TRANSFERS; i++) {
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+		commandBufferAllocateInfo.commandPool = vkGPU->transferCommandPool;
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+		res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &vkGPU->transfers[i].commandBuffer);
+		if (res != VK_SUCCESS) return res;
+		VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+		res = vkCreateFence(vkGPU->device, &fenceCreateInfo, NULL, &vkGPU->transfers[i].fence);
+		if (res != VK_SUCCESS) return res;
+	}
+	vkGPU->stagingHead = 0;
+	vkGPU->nextTransferID = 1;
+	vkGPU->retiredTransferID = 0;
+	return res;
+}
+VkResult createShaderModule(VkGPU* vkGPU, VkShaderModule* shaderModule, uint32_t shaderID, uint32_t dataType) {
+	//create shader module, using the SPIR-V bytecode
+	VkResult res = VK_SUCCESS;
+	const char* shaderName;
+	char shaderPath[1024];
+	//this sample uses multiple compute shaders, that can be selected by passing an appropriate id
+	switch (shaderID) {
+	case 0:
+		shaderName = "transposition_no_bank_conflicts";
+		break;
+	case 1:
+		shaderName = "transposition_bank_conflicts";
+		break;
+	case 2:
+		shaderName = "transfer";
+		break;
+	case 3:
+		shaderName = "permutation";
+		break;
+	case 4:
+		shaderName = "transposition_in_place";
+		break;
+	case 5:
+		shaderName = "transposition_in_place_rectangular";
+		break;
+	case 6:
+		shaderName = "bandwidth";
+		break;
+	case 7:
+		shaderName = "transposition_subgroup";
+		break;
+	default:
+		return VK_ERROR_INITIALIZATION_FAILED;
+	}
+	//each shader is compiled once per element size
+	snprintf(shaderPath, sizeof(shaderPath), "%s%s%s.spv", (vkGPU->shaderDir) ? vkGPU->shaderDir : SHADER_DIR, shaderName, dataTypes[dataType].shaderSuffix);
+	uint32_t filelength;
+	//read bytecode
+	uint32_t* code = VkFFTReadShader(&filelength, shaderPath);
+	VkShaderModuleCreateInfo createInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+	createInfo.pCode = code;
+	createInfo.codeSize = filelength;
+	res = vkCreateShaderModule(vkGPU->device, &createInfo, NULL, shaderModule);
+	free(code);
+	return res;
+}
+uint32_t greatestCommonDivisor(uint32_t a, uint32_t b) {
+	while (b != 0) {
+		uint32_t r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+VkResult configurePermutation(VkGPU* vkGPU, VkApplication* app) {
+	//select the axes of the tensor permutation, that are tiled through shared memory, and fill the specialization constants and dispatch size
+	uint32_t numAxes = app->numAxes;
+	if ((numAxes == 0) || (numAxes > VK_APP_MAX_AXES)) return VK_ERROR_INITIALIZATION_FAILED;
+	uint32_t usedAxes = 0;
+	for (uint32_t i = 0; i < numAxes; i++) {
+		if ((app->permutation[i] >= numAxes) || (usedAxes & (1 << app->permutation[i]))) return VK_ERROR_INITIALIZATION_FAILED;
+		usedAxes |= 1 << app->permutation[i];
+	}
+	//strides of each input axis in the packed input and in the packed output
+	uint32_t inputStride[VK_APP_MAX_AXES];
+	uint32_t outputStride[VK_APP_MAX_AXES];
+	uint32_t stride = 1;
+	for (uint32_t i = 0; i < numAxes; i++) {
+		inputStride[i] = stride;
+		stride *= app->axes[i];
+	}
+	stride = 1;
+	for (uint32_t i = 0; i < numAxes; i++) {
+		outputStride[app->permutation[i]] = stride;
+		stride *= app->axes[app->permutation[i]];
+	}
+	//merge input axes that stay adjacent and in the same order in the output, axes of extent 1 are dropped. Groups are listed in the output order
+	uint32_t numGroups = 0;
+	uint32_t groupExtent[VK_APP_MAX_AXES];
+	uint32_t groupInputStride[VK_APP_MAX_AXES];
+	uint32_t groupOutputStride[VK_APP_MAX_AXES];
+	uint32_t lastAxis = 0;
+	for (uint32_t i = 0; i < numAxes; i++) {
+		uint32_t axis = app->permutation[i];
+		if (app->axes[axis] == 1) continue;
+		uint32_t adjacent = (numGroups > 0) && (axis > lastAxis);
+		for (uint32_t j = lastAxis + 1; adjacent && (j < axis); j++) {
+			if (app->axes[j] != 1) adjacent = 0;
+		}
+		if (adjacent) {
+			groupExtent[numGroups - 1] *= app->axes[axis];
+		}
+		else {
+			groupExtent[numGroups] = app->axes[axis];
+			groupInputStride[numGroups] = inputStride[axis];
+			groupOutputStride[numGroups] = outputStride[axis];
+			numGroups++;
+		}
+		lastAxis = axis;
+	}
+	if (numGroups == 0) {
+		//single element tensor
+		groupExtent[0] = 1;
+		groupInputStride[0] = 1;
+		groupOutputStride[0] = 1;
+		numGroups = 1;
+	}
+	//axis A is the group that is contiguous in the input, group 0 is contiguous in the output
+	uint32_t axis_A = 0;
+	for (uint32_t i = 0; i < numGroups; i++) {
+		if (groupInputStride[i] == 1) axis_A = i;
+	}
+	//if the innermost axis stays in place, reads and writes are coalesced along it without shared memory, and the tile is a plain strided copy
+	uint32_t transposeTile = (axis_A != 0);
+	int32_t axis_B = (transposeTile) ? 0 : ((numGroups > 1) ? 1 : -1);
+	VkAppSpecializationConstantsLayout* constants = &app->specializationConstants;
+	constants->transposeTile = transposeTile;
+	constants->tileExtent[0] = groupExtent[axis_A];
+	constants->tileInputStride[0] = groupInputStride[axis_A];
+	constants->tileOutputStride[0] = groupOutputStride[axis_A];
+	constants->tileExtent[1] = (axis_B >= 0) ? groupExtent[axis_B] : 1;
+	constants->tileInputStride[1] = (axis_B >= 0) ? groupInputStride[axis_B] : 0;
+	constants->tileOutputStride[1] = (axis_B >= 0) ? groupOutputStride[axis_B] : 0;
+	//all other groups are not tiled
+	uint32_t numBatchAxes = 0;
+	constants->batchCount = 1;
+	for (uint32_t i = 0; i < numGroups; i++) {
+		if ((i == axis_A) || ((int32_t)i == axis_B)) continue;
+		constants->batchExtent[numBatchAxes] = groupExtent[i];
+		constants->batchInputStride[numBatchAxes] = groupInputStride[i];
+		constants->batchOutputStride[numBatchAxes] = groupOutputStride[i];
+		constants->batchCount *= groupExtent[i];
+		numBatchAxes++;
+	}
+	for (uint32_t i = numBatchAxes; i < 4; i++) {
+		constants->batchExtent[i] = 1;
+		constants->batchInputStride[i] = 0;
+		constants->batchOutputStride[i] = 0;
+	}
+	//tiles and batches that do not fit in the maximum workgroup count are processed in loops in the shader
+	uint32_t* maxWorkGroupCount = vkGPU->physicalDeviceProperties.limits.maxComputeWorkGroupCount;
+	uint32_t numTiles[2];
+	numTiles[0] = (constants->tileExtent[0] + constants->localSize[0] - 1) / constants->localSize[0];
+	numTiles[1] = (constants->tileExtent[1] + constants->localSize[1] - 1) / constants->localSize[1];
+	app->dispatchSize[0] = (numTiles[0] < maxWorkGroupCount[0]) ? numTiles[0] : maxWorkGroupCount[0];
+	app->dispatchSize[1] = (numTiles[1] < maxWorkGroupCount[1]) ? numTiles[1] : maxWorkGroupCount[1];
+	app->dispatchSize[2] = (constants->batchCount < maxWorkGroupCount[2]) ? constants->batchCount : maxWorkGroupCount[2];
+	return VK_SUCCESS;
+}
+void getAppStrides(VkApplication* app, uint32_t* inputStride, uint32_t* outputStride) {
+	//buffer strides for multidimensional data, packed by default. Output of the transposition has size[1] columns and size[0] rows, output of the transfer shader has the shape of the input
+	uint32_t outputColumns = (app->shaderID == 2) ? app->size[0] : app->size[1];
+	uint32_t outputRows = (app->shaderID == 2) ? app->size[1] : app->size[0];
+	inputStride[0] = 1;
+	inputStride[1] = (app->inputRowStride) ? app->inputRowStride : app->size[0];
+	inputStride[2] = (app->inputMatrixStride) ? app->inputMatrixStride : inputStride[1] * app->size[1];
+	outputStride[0] = 1;
+	outputStride[1] = (app->outputRowStride) ? app->outputRowStride : outputColumns;
+	outputStride[2] = (app->outputMatrixStride) ? app->outputMatrixStride : outputStride[1] * outputRows;
+}
+VkResult checkAppStrides(VkApplication* app) {
+	//rows and matrices must not overlap: a row stride covers the row it spans, a matrix stride all rows of the matrix. The in-place transposition (shaderID 4) has no separate output
+	uint32_t inputStride[3];
+	uint32_t outputStride[3];
+	getAppStrides(app, inputStride, outputStride);
+	uint32_t outputColumns = (app->shaderID == 2) ? app->size[0] : app->size[1];
+	uint32_t outputRows = (app->shaderID == 2) ? app->size[1] : app->size[0];
+	if ((inputStride[1] < app->size[0]) || ((uint64_t)inputStride[2] < (uint64_t)inputStride[1] * app->size[1])) return VK_ERROR_INITIALIZATION_FAILED;
+	if (app->shaderID == 4) return VK_SUCCESS;
+	if ((outputStride[1] < outputColumns) || ((uint64_t)outputStride[2] < (uint64_t)outputStride[1] * outputRows)) return VK_ERROR_INITIALIZATION_FAILED;
+	return VK_SUCCESS;
+}
+void setAppShape(VkGPU* vkGPU, VkApplication* app) {
+	//pass the size and strides to the shader: as specialization constants, or as push constants if the plan has a dynamic shape. Specialization constants of dynamic plans keep default values, so they share one pipeline
+	uint32_t inputStride[3];
+	uint32_t outputStride[3];
+	getAppStrides(app, inputStride, outputStride);
+	for (uint32_t i = 0; i < 3; i++) {
+		app->specializationConstants.inputStride[i] = (app->dynamicShape) ? 1 : inputStride[i];
+		app->specializationConstants.outputStride[i] = (app->dynamicShape) ? 1 : outputStride[i];
+		app->specializationConstants.size[i] = (app->dynamicShape) ? 1 : app->size[i];
+		app->pushConstants.inputStride[i] = inputStride[i];
+		app->pushConstants.outputStride[i] = outputStride[i];
+	}
+	for (uint32_t i = 0; i < 3; i++)
+		app->pushConstants.size[i] = app->size[i];
+	if (app->shaderID <= 2) {
+		//one workgroup per tile, sizes that are not multiples of the tile get an additional edge workgroup. Larger grids are clamped to the device limit, the shaders loop over the remaining tiles and matrices
+		uint32_t* maxWorkGroupCount = vkGPU->physicalDeviceProperties.limits.maxComputeWorkGroupCount;
+		app->dispatchSize[0] = (app->size[0] + app->tileDim - 1) / app->tileDim;
+		app->dispatchSize[1] = (app->size[1] + app->tileDim - 1) / app->tileDim;
+		app->dispatchSize[2] = app->size[2];
+		for (uint32_t i = 0; i < 3; i++) {
+			if (app->dispatchSize[i] > maxWorkGroupCount[i]) app->dispatchSize[i] = maxWorkGroupCount[i];
+		}
+	}
+}
+VkResult reshapeApp(VkGPU* vkGPU, VkApplication* app) {
+	//apply the size and strides of a plan created with dynamicShape, the pipeline is reused
+	if ((!app->dynamicShape) || (app->shaderID > 2)) return VK_ERROR_INITIALIZATION_FAILED;
+	VkResult res = checkAppStrides(app);
+	if (res != VK_SUCCESS) return res;
+	setAppShape(vkGPU, app);
+	//the recorded command buffer holds the old push constants and dispatch size
+	app->recordedDescriptorSet = VK_NULL_HANDLE;
+	return VK_SUCCESS;
+}
+VkResult bindApp(VkGPU* vkGPU, VkApplication* app, VkBuffer* inputBuffer, VkDeviceSize inputBufferSize, VkBuffer* outputBuffer, VkDeviceSize outputBufferSize) {
+	//write the buffers to the next descriptor set of the ring. The pipeline does not depend on the buffers, so a new buffer pair costs only a descriptor update
+	//a set is only rewritten after descriptorSetCount calls, so command buffers recorded with the other sets of the ring are not affected by the update
+	if (app->shaderID == 5) {
+		//the scratch buffer of the rectangular in-place transposition has to hold scratchLines rows or columns
+		uint32_t maxSize = (app->size[0] > app->size[1]) ? app->size[0] : app->size[1];
+		if (outputBufferSize < (VkDeviceSize)dataTypes[app->dataType].size * app->scratchLines * maxSize) return VK_ERROR_INITIALIZATION_FAILED;
+	}
+	VkDescriptorSet descriptorSet = app->descriptorSets[app->descriptorSetIndex];
+	VkDescriptorBufferInfo descriptorBufferInfo[2] = { 0 };
+	descriptorBufferInfo[0].buffer = inputBuffer[0];
+	descriptorBufferInfo[0].range = inputBufferSize;
+	descriptorBufferInfo[0].offset = 0;
+	descriptorBufferInfo[1].buffer = outputBuffer[0];
+	descriptorBufferInfo[1].range = outputBufferSize;
+	descriptorBufferInfo[1].offset = 0;
+	//both bindings are consecutive storage buffers, so they are updated with one write
+	VkWriteDescriptorSet writeDescriptorSet = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+	writeDescriptorSet.dstSet = descriptorSet;
+	writeDescriptorSet.dstBinding = 0;
+	writeDescriptorSet.dstArrayElement = 0;
+	writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	writeDescriptorSet.descriptorCount = 2;
+	writeDescriptorSet.pBufferInfo = descriptorBufferInfo;
+	vkUpdateDescriptorSets(vkGPU->device, 1, &writeDescriptorSet, 0, NULL);
+	//the update invalidates the command buffer if it was recorded with this set (always with one set in the ring), so executeApp records it again
+	if (descriptorSet == app->recordedDescriptorSet) app->recordedDescriptorSet = VK_NULL_HANDLE;
+	app->descriptorSet = descriptorSet;
+	app->descriptorSetIndex = (app->descriptorSetIndex + 1) % app->descriptorSetCount;
+	app->inputBuffer = inputBuffer;
+	app->inputBufferSize = inputBufferSize;
+	app->outputBuffer = outputBuffer;
+	app->outputBufferSize = outputBufferSize;
+	return VK_SUCCESS;
+}
+VkResult createApp(VkGPU* vkGPU, VkApplication* app, uint32_t shaderID) {
+	//create an application interface to Vulkan. This function binds the shader to the compute pipeline, so it can be used as a part of the command buffer later
+	VkResult res = VK_SUCCESS;
+	if (app->dataType >= VK_APP_NUM_DATA_TYPES) return VK_ERROR_INITIALIZATION_FAILED;
+	uint32_t elementSize = dataTypes[app->dataType].size;
+	//8- and 16-bit elements are only supported if the device can access them in storage buffers
+	if (((elementSize == 1) && (!vkGPU->storage8Bit)) || ((elementSize == 2) && (!vkGPU->storage16Bit))) return VK_ERROR_FEATURE_NOT_PRESENT;
+	if ((app->vectorWidth != 0) && (app->vectorWidth != 1) && (app->vectorWidth != 2) && (app->vectorWidth != 4)) return VK_ERROR_INITIALIZATION_FAILED;
+	if ((shaderID <= 1) && (vkGPU->tuningPath != NULL) && (!app->dynamicShape) && (app->tileDim == 0) && (app->blockRows == 0) && (app->vectorWidth == 0)) {
+		//2D transposition without a tile configuration uses the one tuned for the device, data type and size. shaderID 0 is the default transposition, so it also takes the faster shader of the record
+		VkAppTuningRecord tuningRecord = { 0 };
+		if (findTuningRecord(vkGPU, vkGPU->tuningPath, app->dataType, app->size[0], app->size[1], &tuningRecord)) {
+			app->tileDim = tuningRecord.tileDim;
+			app->blockRows = tuningRecord.blockRows;
+			app->vectorWidth = tuningRecord.vectorWidth;
+			if ((shaderID == 0) && (tuningRecord.shaderID <= 1)) shaderID = tuningRecord.shaderID;
+			app->tuned = 1;
+		}
+	}
+	if (((shaderID == 3) || (shaderID == 5)) && (app->inputRowStride || app->inputMatrixStride || app->outputRowStride || app->outputMatrixStride)) return VK_ERROR_INITIALIZATION_FAILED;
+	if ((shaderID > 2) && (app->dynamicShape)) return VK_ERROR_INITIALIZATION_FAILED;
+	if ((app->tileOrder > VK_APP_TILE_ORDER_SWIZZLED) || ((shaderID > 1) && (app->tileOrder))) return VK_ERROR_INITIALIZATION_FAILED;
+	if (app->coalescedMemory == 0) app->coalescedMemory = defaultCoalescedMemory(vkGPU);
+	//in-place transposition swaps tile pairs, which is only defined for square matrices
+	if ((shaderID == 4) && (app->size[0] != app->size[1])) return VK_ERROR_INITIALIZATION_FAILED;
+	if (shaderID == 6) {
+		//bandwidth probes move whole vec4 and every word of the strided side once
+		if (app->probeStride == 0) app->probeStride = 1;
+		if ((app->probe > VK_APP_PROBE_COPY_BUFFER) || (app->size[0] % 4) || (app->size[0] % app->probeStride) || (app->size[1] != 1) || (app->size[2] != 1)) return VK_ERROR_INITIALIZATION_FAILED;
+	}
+	if (shaderID == 7) {
+		//the subgroup shuffle transposition needs shuffles in compute shaders and keeps one tile column per lane in registers, so subgroups of 4 to 64 lanes (a power of two) are used
+		if (vkGPU->apiVersion < VK_API_VERSION_1_1) return VK_ERROR_FEATURE_NOT_PRESENT;
+		VkPhysicalDeviceProperties2 deviceProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+		VkPhysicalDeviceSubgroupProperties subgroupProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES };
+		deviceProperties.pNext = &subgroupProperties;
+		vkGPU->getPhysicalDeviceProperties2(vkGPU->physicalDevice, &deviceProperties);
+		uint32_t subgroupSize = subgroupProperties.subgroupSize;
+		if ((!(subgroupProperties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT)) || (!(subgroupProperties.supportedOperations & VK_SUBGROUP_FEATURE_SHUFFLE_BIT))) return VK_ERROR_FEATURE_NOT_PRESENT;
+		if ((subgroupSize < 4) || (subgroupSize > 64) || (subgroupSize & (subgroupSize - 1)) || (subgroupSize > vkGPU->physicalDeviceProperties.limits.maxComputeWorkGroupSize[0])) return VK_ERROR_FEATURE_NOT_PRESENT;
+		//the tile edge has to be the subgroup size, so it can not be reduced. Each lane holds a tile column and half of it again during the rotations: above 64 32-bit words per column
+		//(64-bit elements in 64-lane subgroups, 128-bit elements in 32- and 64-lane subgroups) the registers spill to memory and the kernel is slower than the shared memory one
+		uint32_t registerWords = subgroupSize * ((elementSize > 4) ? elementSize / 4 : 1);
+		if (registerWords > 64) return VK_ERROR_FEATURE_NOT_PRESENT;
+		app->specializationConstants.subgroupTile = subgroupSize;
+		app->tileDim = subgroupSize;
+	}
+	if (shaderID == 5) {
+		//rectangular in-place transposition uses one scratch buffer, so it transposes one matrix at a time
+		if (app->size[2] != 1) return VK_ERROR_INITIALIZATION_FAILED;
+		if (app->scratchLines == 0) app->scratchLines = 64;
+	}
+	//bindApp checks the buffers against the shader
+	app->shaderID = shaderID;
+	res = checkAppStrides(app);
+	if (res != VK_SUCCESS) return res;
+	//we have two storage buffer objects in each set of the ring, all sets are allocated from one pool
+	if (app->descriptorSetCount == 0) app->descriptorSetCount = 8;
+	const uint32_t descriptorCount = 2;
+	VkDescriptorPoolSize descriptorPoolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
+	descriptorPoolSize.descriptorCount = descriptorCount * app->descriptorSetCount;
+
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+	descriptorPoolCreateInfo.poolSizeCount = 1;
+	descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+	descriptorPoolCreateInfo.maxSets = app->descriptorSetCount;
+	res = vkCreateDescriptorPool(vkGPU->device, &descriptorPoolCreateInfo, NULL, &app->descriptorPool);
+	if (res != VK_SUCCESS) return res;
+	//specify each object from the set as a storage buffer
+	const VkDescriptorType descriptorType[2] = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
+	VkDescriptorSetLayoutBinding* descriptorSetLayoutBindings = (VkDescriptorSetLayoutBinding*)malloc(descriptorCount * sizeof(VkDescriptorSetLayoutBinding));
+	for (uint32_t i = 0; i < descriptorCount; ++i) {
+		descriptorSetLayoutBindings[i].binding = i;
+		descriptorSetLayoutBindings[i].descriptorType = descriptorType[i];
+		descriptorSetLayoutBindings[i].descriptorCount = 1;
+		descriptorSetLayoutBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+	descriptorSetLayoutCreateInfo.bindingCount = descriptorCount;
+	descriptorSetLayoutCreateInfo.pBindings = descriptorSetLayoutBindings;
+	//create layout
+	res = vkCreateDescriptorSetLayout(vkGPU->device, &descriptorSetLayoutCreateInfo, NULL, &app->descriptorSetLayout);
+	if (res != VK_SUCCESS) return res;
+	free(descriptorSetLayoutBindings);
+	//allocate the ring of descriptor sets and provide the first one with actual buffers and their sizes
+	VkDescriptorSetLayout* descriptorSetLayouts = (VkDescriptorSetLayout*)malloc(app->descriptorSetCount * sizeof(VkDescriptorSetLayout));
+	for (uint32_t i = 0; i < app->descriptorSetCount; ++i)
+		descriptorSetLayouts[i] = app->descriptorSetLayout;
+	app->descriptorSets = (VkDescriptorSet*)malloc(app->descriptorSetCount * sizeof(VkDescriptorSet));
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+	descriptorSetAllocateInfo.descriptorPool = app->descriptorPool;
+	descriptorSetAllocateInfo.descriptorSetCount = app->descriptorSetCount;
+	descriptorSetAllocateInfo.pSetLayouts = descriptorSetLayouts;
+	res = vkAllocateDescriptorSets(vkGPU->device, &descriptorSetAllocateInfo, app->descriptorSets);
+	free(descriptorSetLayouts);
+	if (res != VK_SUCCESS) return res;
+	app->descriptorSetIndex = 0;
+	res = bindApp(vkGPU, app, app->inputBuffer, app->inputBufferSize, app->outputBuffer, app->outputBufferSize);
+	if (res != VK_SUCCESS) return res;
+
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+	pipelineLayoutCreateInfo.setLayoutCount = 1;
+	pipelineLayoutCreateInfo.pSetLayouts = &app->descriptorSetLayout;
+	//specify how many push constants can be specified when the pipeline is bound to the command buffer
+	VkPushConstantRange pushConstantRange = { VK_SHADER_STAGE_COMPUTE_BIT };
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(VkAppPushConstantsLayout);
+	pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+	pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+	//create pipeline layout
+	res = vkCreatePipelineLayout(vkGPU->device, &pipelineLayoutCreateInfo, NULL, &app->pipelineLayout);
+	if (res != VK_SUCCESS) return res;
+	VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
+
+	VkComputePipelineCreateInfo computePipelineCreateInfo = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+	//specify specialization constants - structure that sets constants in the shader after first compilation (done by glslangvalidator, for example) but before final shader module creation
+	//first three values - workgroup dimensions. A tile row covers coalescedMemory bytes, so narrow types get wider tiles. The tile is halved until it fits in the workgroup and shared memory limits
+	//shared memory holds 8- and 16-bit elements as 32-bit values, the square in-place transposition keeps two tiles
+	VkPhysicalDeviceLimits* limits = &vkGPU->physicalDeviceProperties.limits;
+	uint32_t sharedElementSize = (elementSize > 4) ? elementSize : 4;
+	uint32_t sharedTiles = (shaderID == 4) ? 2 : 1;
+	uint32_t tileSize = (app->coalescedMemory > elementSize) ? app->coalescedMemory / elementSize : 1;
+	if (shaderID <= 2) {
+		//2D transposition and transfer shaders decouple the workgroup from the tile, so small coalescing widths do not result in tiny workgroups. By default the tile is at least 32 elements wide and the workgroup has 8 thread rows
+		uint32_t tileDim = (app->tileDim) ? app->tileDim : ((tileSize > 32) ? tileSize : 32);
+		uint32_t blockRows = (app->blockRows) ? app->blockRows : 8;
+		//vector access is only compiled for 32-bit elements. It also needs rows of the input and the output to start at multiples of vectorWidth, dynamic plans check this for each shape in the shader
+		uint32_t inputStride[3];
+		uint32_t outputStride[3];
+		getAppStrides(app, inputStride, outputStride);
+		uint32_t vectorWidth = (app->vectorWidth) ? app->vectorWidth : 1;
+		if ((elementSize != 4) || ((!app->dynamicShape) && ((app->size[0] % vectorWidth) || (app->size[1] % vectorWidth) || (inputStride[1] % vectorWidth) || (inputStride[2] % vectorWidth) || (outputStride[1] % vectorWidth) || (outputStride[2] % vectorWidth)))) vectorWidth = 1;
+		while ((tileDim > 1) && (tileDim * (tileDim + 1) * sharedElementSize > limits->maxComputeSharedMemorySize))
+			tileDim /= 2;
+		if (tileDim % vectorWidth) vectorWidth = 1;
+		if (tileDim / vectorWidth > limits->maxComputeWorkGroupSize[0]) return VK_ERROR_INITIALIZATION_FAILED;
+		if (blockRows > tileDim) blockRows = tileDim;
+		while ((blockRows > 1) && ((tileDim / vectorWidth * blockRows > limits->maxComputeWorkGroupInvocations) || (blockRows > limits->maxComputeWorkGroupSize[1])))
+			blockRows /= 2;
+		if (tileDim / vectorWidth * blockRows > limits->maxComputeWorkGroupInvocations) return VK_ERROR_INITIALIZATION_FAILED;
+		app->tileDim = tileDim;
+		app->blockRows = blockRows;
+		app->vectorWidth = vectorWidth;
+		app->specializationConstants.localSize[0] = tileDim / vectorWidth;
+		app->specializationConstants.localSize[1] = blockRows;
+		app->specializationConstants.vectorWidth = vectorWidth;
+		app->specializationConstants.tileOrder = app->tileOrder;
+	}
+	else {
+		while ((tileSize > 1) && ((tileSize * tileSize > limits->maxComputeWorkGroupInvocations) || (tileSize > limits->maxComputeWorkGroupSize[0]) || (tileSize > limits->maxComputeWorkGroupSize[1]) || (sharedTiles * tileSize * (tileSize + 1) * sharedElementSize > limits->maxComputeSharedMemorySize)))
+			tileSize /= 2;
+		app->specializationConstants.localSize[0] = tileSize;
+		app->specializationConstants.localSize[1] = tileSize;
+	}
+	app->specializationConstants.localSize[2] = 1;
+	app->specializationConstants.dynamicShape = app->dynamicShape;
+	setAppShape(vkGPU, app);
+	if (shaderID == 5) {
+		uint32_t c = greatestCommonDivisor(app->size[0], app->size[1]);
+		app->specializationConstants.rotationDivisor = app->size[0] / c;
+		app->specializationConstants.shuffleDivisor = app->size[1] / c;
+		app->specializationConstants.scratchLines = app->scratchLines;
+	}
+	if (shaderID == 3) {
+		//tensor permutation has its own set of constants
+		res = configurePermutation(vkGPU, app);
+		if (res != VK_SUCCESS) return res;
+	}
+	else if (shaderID == 6) {
+		//one-dimensional workgroups of up to 256 threads in a grid-stride loop over the vec4 or the words of the probe
+		uint32_t localSize = (limits->maxComputeWorkGroupInvocations < 256) ? limits->maxComputeWorkGroupInvocations : 256;
+		if (localSize > limits->maxComputeWorkGroupSize[0]) localSize = limits->maxComputeWorkGroupSize[0];
+		uint32_t items = (app->probe <= VK_APP_PROBE_WRITE) ? app->size[0] / 4 : app->size[0];
+		app->specializationConstants.localSize[0] = localSize;
+		app->specializationConstants.localSize[1] = 1;
+		app->specializationConstants.probe = app->probe;
+		app->specializationConstants.probeStride = app->probeStride;
+		app->dispatchSize[0] = (items + localSize - 1) / localSize;
+		if (app->dispatchSize[0] > limits->maxComputeWorkGroupCount[0]) app->dispatchSize[0] = limits->maxComputeWorkGroupCount[0];
+		app->dispatchSize[1] = 1;
+		app->dispatchSize[2] = 1;
+	}
+	else if (shaderID == 7) {
+		//a row of subgroups per workgroup, each of them transposes one tile. Up to 256 threads, the shader checks that the pipeline got the queried subgroup size
+		uint32_t subgroupTile = app->specializationConstants.subgroupTile;
+		uint32_t tilesPerWorkgroup = (subgroupTile < 256) ? 256 / subgroupTile : 1;
+		while ((tilesPerWorkgroup > 1) && ((tilesPerWorkgroup * subgroupTile > limits->maxComputeWorkGroupInvocations) || (tilesPerWorkgroup * subgroupTile > limits->maxComputeWorkGroupSize[0])))
+			tilesPerWorkgroup /= 2;
+		app->specializationConstants.localSize[0] = tilesPerWorkgroup * subgroupTile;
+		app->specializationConstants.localSize[1] = 1;
+		app->dispatchSize[0] = ((app->size[0] + subgroupTile - 1) / subgroupTile + tilesPerWorkgroup - 1) / tilesPerWorkgroup;
+		app->dispatchSize[1] = (app->size[1] + subgroupTile - 1) / subgroupTile;
+		app->dispatchSize[2] = app->size[2];
+		//the shader loops over the tiles and matrices beyond the device limit
+		for (uint32_t i = 0; i < 3; i++) {
+			if (app->dispatchSize[i] > limits->maxComputeWorkGroupCount[i]) app->dispatchSize[i] = limits->maxComputeWorkGroupCount[i];
+		}
+	}
+	else if (shaderID > 2) {
+		//sizes that are not multiples of the workgroup size get an additional edge workgroup
+		for (uint32_t i = 0; i < 3; i++) {
+			app->dispatchSize[i] = (app->size[i] + app->specializationConstants.localSize[i] - 1) / app->specializationConstants.localSize[i];
+		}
+	}
+	//all shaders share one specialization constants layout: constantIDs are consecutive, starting from 1. Constants, that are not declared in the shader, are ignored
+	const uint32_t specializationConstantsCount = sizeof(VkAppSpecializationConstantsLayout) / sizeof(uint32_t);
+	VkSpecializationMapEntry specializationMapEntries[sizeof(VkAppSpecializationConstantsLayout) / sizeof(uint32_t)] = { 0 };
+	for (uint32_t i = 0; i < specializationConstantsCount; i++) {
+		specializationMapEntries[i].constantID = i + 1;
+		specializationMapEntries[i].size = sizeof(uint32_t);
+		specializationMapEntries[i].offset = i * sizeof(uint32_t);
+	}
+	VkSpecializationInfo specializationInfo = { 0 };
+	specializationInfo.dataSize = specializationConstantsCount * sizeof(uint32_t);
+	specializationInfo.mapEntryCount = specializationConstantsCount;
+	specializationInfo.pMapEntries = specializationMapEntries;
+	specializationInfo.pData = &app->specializationConstants;
+
+	pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	//create a shader module from the byte code
+	res = createShaderModule(vkGPU, &pipelineShaderStageCreateInfo.module, shaderID, app->dataType);
+	if (res != VK_SUCCESS) return res;
+	pipelineShaderStageCreateInfo.pSpecializationInfo = &specializationInfo;
+	pipelineShaderStageCreateInfo.pName = "main";
+	computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
+	computePipelineCreateInfo.layout = app->pipelineLayout;
+	//create pipeline
+	res = vkCreateComputePipelines(vkGPU->device, vkGPU->pipelineCache, 1, &computePipelineCreateInfo, NULL, &app->pipeline);
+	if (res != VK_SUCCESS) return res;
+	vkDestroyShaderModule(vkGPU->device, pipelineShaderStageCreateInfo.module, NULL);
+	return res;
+}
+void appendDispatch(VkApplication* app, VkCommandBuffer* commandBuffer, uint32_t pushID, uint32_t lineOffset, uint32_t dispatchX, uint32_t dispatchY, uint32_t dispatchZ) {
+	//this function appends to the command buffer: push constants, the shader's program dispatch call and the barrier between two compute stages to avoid race conditions 
+	VkMemoryBarrier memory_barrier = {
+				VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+				0,
+				VK_ACCESS_SHADER_WRITE_BIT,
+				VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+	};
+	app->pushConstants.pushID = pushID;
+	app->pushConstants.lineOffset = lineOffset;
+	//specify push constants - small amount of constant data in the shader
+	vkCmdPushConstants(commandBuffer[0], app->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkAppPushConstantsLayout), &app->pushConstants);
+	//record dispatch call to the command buffer - specifies the total amount of workgroups
+	vkCmdDispatch(commandBuffer[0], dispatchX, dispatchY, dispatchZ);
+	//memory synchronization between two compute dispatches
+	vkCmdPipelineBarrier(commandBuffer[0], VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+}
+void appendApp(VkGPU* vkGPU, VkApplication* app, VkCommandBuffer* commandBuffer) {
+	//this function appends to the command buffer: binds pipeline, descriptors and appends the dispatches of the application
+	//bind compute pipeline to the command buffer
+	vkCmdBindPipeline(commandBuffer[0], VK_PIPELINE_BIND_POINT_COMPUTE, app->pipeline);
+	//bind descriptors to the command buffer
+	vkCmdBindDescriptorSets(commandBuffer[0], VK_PIPELINE_BIND_POINT_COMPUTE, app->pipelineLayout, 0, 1, &app->descriptorSet, 0, NULL);
+	if ((app->shaderID == 6) && (app->probe == VK_APP_PROBE_COPY_BUFFER)) {
+		//the copy engine probe records a buffer copy instead of the dispatch, with a barrier between two copies
+		VkBufferCopy copyRegion = { 0 };
+		copyRegion.size = (VkDeviceSize)app->size[0] * sizeof(uint32_t);
+		VkMemoryBarrier memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+		vkCmdCopyBuffer(commandBuffer[0], app->inputBuffer[0], app->outputBuffer[0], 1, &copyRegion);
+		vkCmdPipelineBarrier(commandBuffer[0], VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, NULL, 0, NULL);
+	}
+	else if (app->shaderID == 5) {
+		//rectangular in-place transposition: column rotation (only if gcd(m, n) > 1), row shuffle and column shuffle. Each pass permutes scratchLines rows or columns into the scratch buffer and copies them back
+		uint32_t* localSize = app->specializationConstants.localSize;
+		uint32_t lines = app->scratchLines;
+		uint32_t columnPassDispatch[2] = { (lines + localSize[0] - 1) / localSize[0], (app->size[1] + localSize[1] - 1) / localSize[1] };
+		uint32_t rowPassDispatch[2] = { (app->size[0] + localSize[0] - 1) / localSize[0], (lines + localSize[1] - 1) / localSize[1] };
+		if (app->specializationConstants.rotationDivisor != app->size[0]) {
+			for (uint32_t j = 0; j < app->size[0]; j += lines) {
+				appendDispatch(app, commandBuffer, 0, j, columnPassDispatch[0], columnPassDispatch[1], 1);
+				appendDispatch(app, commandBuffer, 2, j, columnPassDispatch[0], columnPassDispatch[1], 1);
+			}
+		}
+		for (uint32_t i = 0; i < app->size[1]; i += lines) {
+			appendDispatch(app, commandBuffer, 3, i, rowPassDispatch[0], rowPassDispatch[1], 1);
+			appendDispatch(app, commandBuffer, 4, i, rowPassDispatch[0], rowPassDispatch[1], 1);
+		}
+		for (uint32_t j = 0; j < app->size[0]; j += lines) {
+			appendDispatch(app, commandBuffer, 1, j, columnPassDispatch[0], columnPassDispatch[1], 1);
+			appendDispatch(app, commandBuffer, 2, j, columnPassDispatch[0], columnPassDispatch[1], 1);
+		}
+	}
+	else {
+		appendDispatch(app, commandBuffer, 0, 0, app->dispatchSize[0], app->dispatchSize[1], app->dispatchSize[2]);
+	}
+}
+double getWallTime() {
+	//wall clock time in ms. clock() measures CPU time of the process, which does not advance while the host waits for the GPU
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+uint32_t getCoreCount() {
+	//number of online logical processors
+#ifdef _WIN32
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	return (systemInfo.dwNumberOfProcessors > 0) ? (uint32_t)systemInfo.dwNumberOfProcessors : 1;
+#else
+	long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+	return (numCores > 0) ? (uint32_t)numCores : 1;
+#endif
+}
+typedef struct {
+	void (*function)(void*, uint32_t);
+	void* data;
+	uint32_t id;
+} VkAppThreadArguments;
+#ifdef _WIN32
+DWORD WINAPI threadEntry(LPVOID arguments) {
+	VkAppThreadArguments* threadArguments = (VkAppThreadArguments*)arguments;
+	threadArguments->function(threadArguments->data, threadArguments->id);
+	return 0;
+}
+#else
+void* threadEntry(void* arguments) {
+	VkAppThreadArguments* threadArguments = (VkAppThreadArguments*)arguments;
+	threadArguments->function(threadArguments->data, threadArguments->id);
+	return NULL;
+}
+#endif
+VkResult runThreads(uint32_t numThreads, void (*function)(void*, uint32_t), void* data) {
+	//fork-join over Win32 threads or pthreads. If a thread can not be started, its id runs on the calling thread after id 0
+	VkAppThreadArguments* threadArguments = (VkAppThreadArguments*)malloc(numThreads * sizeof(VkAppThreadArguments));
+	uint8_t* started = (uint8_t*)calloc(numThreads, sizeof(uint8_t));
+#ifdef _WIN32
+	HANDLE* threads = (HANDLE*)malloc(numThreads * sizeof(HANDLE));
+#else
+	pthread_t* threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+#endif
+	if ((threadArguments == NULL) || (started == NULL) || (threads == NULL)) {
+		free(threadArguments);
+		free(started);
+		free(threads);
+		return VK_ERROR_OUT_OF_HOST_MEMORY;
+	}
+	for (uint32_t i = 1; i < numThreads; i++) {
+		threadArguments[i].function = function;
+		threadArguments[i].data = data;
+		threadArguments[i].id = i;
+#ifdef _WIN32
+		threads[i] = CreateThread(NULL, 0, threadEntry, &threadArguments[i], 0, NULL);
+		started[i] = (threads[i] != NULL);
+#else
+		started[i] = (pthread_create(&threads[i], NULL, threadEntry, &threadArguments[i]) == 0);
+#endif
+	}
+	function(data, 0);
+	for (uint32_t i = 1; i < numThreads; i++) {
+		if (!started[i]) {
+			function(data, i);
+			continue;
+		}
+#ifdef _WIN32
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+#else
+		pthread_join(threads[i], NULL);
+#endif
+	}
+	free(threadArguments);
+	free(started);
+	free(threads);
+	return VK_SUCCESS;
+}
+int compareDoubles(const void* a, const void* b) {
+	//comparator for qsort
+	double diff = ((const double*)a)[0] - ((const double*)b)[0];
+	return (diff > 0) - (diff < 0);
+}
+VkResult runApp(VkGPU* vkGPU, VkApplication* app, uint32_t batch, VkAppTimings* timings) {
+	VkResult res = VK_SUCCESS;
+	//the statistics need at least one run, and a query pool can not be empty
+	if (batch == 0) return VK_ERROR_INITIALIZATION_FAILED;
+	//timestamps are written before and after each appendApp call, if the queue family supports them
+	uint32_t useTimestamps = (vkGPU->timestampValidBits > 0) && (vkGPU->physicalDeviceProperties.limits.timestampPeriod > 0);
+	VkQueryPool queryPool = VK_NULL_HANDLE;
+	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+	uint32_t submitted = 0;
+	double* dispatchTimes = NULL;
+	uint64_t* timestamps = NULL;
+	if (useTimestamps) {
+		VkQueryPoolCreateInfo queryPoolCreateInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+		queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCreateInfo.queryCount = 2 * batch;
+		res = vkCreateQueryPool(vkGPU->device, &queryPoolCreateInfo, NULL, &queryPool);
+		if (res != VK_SUCCESS) goto cleanup;
+	}
+	//create command buffer to be executed on the GPU
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = vkGPU->commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &commandBuffer);
+	if (res != VK_SUCCESS) goto cleanup;
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	//begin command buffer recording
+	res = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	if (res != VK_SUCCESS) goto cleanup;
+	if (useTimestamps) vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2 * batch);
+	//Record commands batch times. Allows to perform multiple operations in one submit to mitigate dispatch overhead
+	for (uint32_t i = 0; i < batch; i++) {
+		//bottom of pipe timestamps are written when all previous commands have finished, so each pair brackets exactly one appendApp call
+		if (useTimestamps) vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 2 * i);
+		appendApp(vkGPU, app, &commandBuffer);
+		if (useTimestamps) vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 2 * i + 1);
+	}
+	//end command buffer recording
+	res = vkEndCommandBuffer(commandBuffer);
+	if (res != VK_SUCCESS) goto cleanup;
+	//submit the command buffer for execution and place the fence after, measure host time required for submission and execution
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	double hostStart = getWallTime();
+	res = vkQueueSubmit(vkGPU->queue, 1, &submitInfo, vkGPU->fence);
+	if (res != VK_SUCCESS) goto cleanup;
+	submitted = 1;
+	double hostSubmitted = getWallTime();
+	res = vkWaitForFences(vkGPU->device, 1, &vkGPU->fence, VK_TRUE, 100000000000);
+	if (res != VK_SUCCESS) goto cleanup;
+	double hostEnd = getWallTime();
+	res = vkResetFences(vkGPU->device, 1, &vkGPU->fence);
+	if (res != VK_SUCCESS) goto cleanup;
+	submitted = 0;
+
+	timings->hostSubmit = hostSubmitted - hostStart;
+	timings->hostTotal = hostEnd - hostStart;
+	dispatchTimes = (double*)malloc(sizeof(double) * batch);
+	if (dispatchTimes == NULL) {
+		res = VK_ERROR_OUT_OF_HOST_MEMORY;
+		goto cleanup;
+	}
+	if (useTimestamps) {
+		timestamps = (uint64_t*)malloc(sizeof(uint64_t) * 2 * batch);
+		if (timestamps == NULL) {
+			res = VK_ERROR_OUT_OF_HOST_MEMORY;
+			goto cleanup;
+		}
+		res = vkGetQueryPoolResults(vkGPU->device, queryPool, 0, 2 * batch, sizeof(uint64_t) * 2 * batch, timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+		if (res != VK_SUCCESS) goto cleanup;
+		//only timestampValidBits of each value are meaningful, masking the difference also handles counter wrap-around
+		uint64_t timestampMask = (vkGPU->timestampValidBits >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << vkGPU->timestampValidBits) - 1);
+		//timestampPeriod is the number of nanoseconds per timestamp tick
+		double tickToMs = vkGPU->physicalDeviceProperties.limits.timestampPeriod / 1000000.0;
+		for (uint32_t i = 0; i < batch; i++) {
+			dispatchTimes[i] = ((timestamps[2 * i + 1] - timestamps[2 * i]) & timestampMask) * tickToMs;
+		}
+		double batchTime = ((timestamps[2 * batch - 1] - timestamps[0]) & timestampMask) * tickToMs;
+		timings->hostOverhead = timings->hostTotal - batchTime;
+	}
+	else {
+		//no timestamp support - fall back to the host timer, which also includes submit and fence wait overhead
+		for (uint32_t i = 0; i < batch; i++) {
+			dispatchTimes[i] = timings->hostTotal / batch;
+		}
+		timings->hostOverhead = 0;
+	}
+	timings->gpuTimestamps = useTimestamps;
+	qsort(dispatchTimes, batch, sizeof(double), compareDoubles);
+	timings->mean = 0;
+	for (uint32_t i = 0; i < batch; i++) {
+		timings->mean += dispatchTimes[i] / batch;
+	}
+	timings->min = dispatchTimes[0];
+	timings->median = (batch % 2) ? dispatchTimes[batch / 2] : 0.5 * (dispatchTimes[batch / 2 - 1] + dispatchTimes[batch / 2]);
+	//nearest-rank percentile
+	timings->p95 = dispatchTimes[(uint32_t)ceil(0.95 * batch) - 1];
+	timings->max = dispatchTimes[batch - 1];
+cleanup:
+	//a failed wait leaves the command buffer pending, it can only be freed once the queue is idle
+	if (submitted) {
+		vkQueueWaitIdle(vkGPU->queue);
+		vkResetFences(vkGPU->device, 1, &vkGPU->fence);
+	}
+	if (commandBuffer != VK_NULL_HANDLE) vkFreeCommandBuffers(vkGPU->device, vkGPU->commandPool, 1, &commandBuffer);
+	if (queryPool != VK_NULL_HANDLE) vkDestroyQueryPool(vkGPU->device, queryPool, NULL);
+	free(timestamps);
+	free(dispatchTimes);
+	return res;
+}
+VkResult recordApp(VkGPU* vkGPU, VkApplication* app) {
+	//record the dispatches of one application run in the command buffer of the application. The command buffer and the fence are created once and reused by every executeApp call
+	//the command buffer references the descriptor set and the pipeline, so it has to be recorded again if they change. executeApp does it after bindApp
+	VkResult res = VK_SUCCESS;
+	if (app->commandBuffer == VK_NULL_HANDLE) {
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+		commandBufferAllocateInfo.commandPool = vkGPU->commandPool;
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+		res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &app->commandBuffer);
+		if (res != VK_SUCCESS) return res;
+	}
+	if (app->fence == VK_NULL_HANDLE) {
+		VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+		res = vkCreateFence(vkGPU->device, &fenceCreateInfo, NULL, &app->fence);
+		if (res != VK_SUCCESS) return res;
+	}
+	//no ONE_TIME_SUBMIT flag: the command buffer stays executable after the submit
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = 0;
+	res = vkBeginCommandBuffer(app->commandBuffer, &commandBufferBeginInfo);
+	if (res != VK_SUCCESS) return res;
+	appendApp(vkGPU, app, &app->commandBuffer);
+	res = vkEndCommandBuffer(app->commandBuffer);
+	if (res != VK_SUCCESS) return res;
+	app->recordedDescriptorSet = app->descriptorSet;
+	return res;
+}
+VkResult executeApp(VkGPU* vkGPU, VkApplication* app) {
+	//run the application once and wait for it. The command buffer is recorded on the first call, afterwards each call is only a submit, a wait and a fence reset
+	VkResult res = VK_SUCCESS;
+	if ((app->commandBuffer == VK_NULL_HANDLE) || (app->recordedDescriptorSet != app->descriptorSet)) {
+		res = recordApp(vkGPU, app);
+		if (res != VK_SUCCESS) return res;
+	}
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &app->commandBuffer;
+	res = vkQueueSubmit(vkGPU->queue, 1, &submitInfo, app->fence);
+	if (res != VK_SUCCESS) return res;
+	res = vkWaitForFences(vkGPU->device, 1, &app->fence, VK_TRUE, 100000000000);
+	if (res != VK_SUCCESS) return res;
+	res = vkResetFences(vkGPU->device, 1, &app->fence);
+	return res;
+}
+void deleteApp(VkGPU* vkGPU, VkApplication* app) {
+	//destroy previously allocated resources of the application
+	if (app->commandBuffer != VK_NULL_HANDLE) vkFreeCommandBuffers(vkGPU->device, vkGPU->commandPool, 1, &app->commandBuffer);
+	vkDestroyFence(vkGPU->device, app->fence, NULL);
+	vkDestroyDescriptorPool(vkGPU->device, app->descriptorPool, NULL);
+	vkDestroyDescriptorSetLayout(vkGPU->device, app->descriptorSetLayout, NULL);
+	free(app->descriptorSets);
+	vkDestroyPipelineLayout(vkGPU->device, app->pipelineLayout, NULL);
+	vkDestroyPipeline(vkGPU->device, app->pipeline, NULL);
+}
+VkResult measureBandwidth(VkGPU* vkGPU, VkBuffer* inputBuffer, VkBuffer* outputBuffer, VkDeviceSize size, uint32_t batch, VkAppBandwidth* bandwidth) {
+	//each probe is a shaderID 6 plan over the same buffers. Word counts are multiples of 4096, so every stride divides them
+	VkResult res = VK_SUCCESS;
+	uint32_t numWords = (uint32_t)(((size / sizeof(uint32_t) < 0xffffffffull) ? size / sizeof(uint32_t) : 0xffffffffull) / 4096 * 4096);
+	if (numWords == 0) return VK_ERROR_INITIALIZATION_FAILED;
+	double gigabytes = (double)numWords * sizeof(uint32_t) / 1024.0 / 1024.0 / 1024.0;
+	memset(bandwidth, 0, sizeof(VkAppBandwidth));
+	for (uint32_t i = 0; i < VK_APP_NUM_PROBE_STRIDES; i++)
+		bandwidth->strides[i] = 1 << (2 * i);
+	bandwidth->worstStrided = -1;
+	for (uint32_t probe = 0; probe <= VK_APP_PROBE_COPY_BUFFER; probe++) {
+		uint32_t numStrides = ((probe == VK_APP_PROBE_STRIDED_READ) || (probe == VK_APP_PROBE_STRIDED_WRITE)) ? VK_APP_NUM_PROBE_STRIDES : 1;
+		for (uint32_t i = 0; i < numStrides; i++) {
+			VkApplication app = { 0 };
+			app.size[0] = numWords;
+			app.size[1] = 1;
+			app.size[2] = 1;
+			app.probe = probe;
+			app.probeStride = (numStrides > 1) ? bandwidth->strides[i] : 1;
+			app.inputBufferSize = (VkDeviceSize)numWords * sizeof(uint32_t);
+			app.inputBuffer = inputBuffer;
+			app.outputBufferSize = (VkDeviceSize)numWords * sizeof(uint32_t);
+			app.outputBuffer = outputBuffer;
+			res = createApp(vkGPU, &app, 6);
+			if (res != VK_SUCCESS) {
+				deleteApp(vkGPU, &app);
+				return res;
+			}
+			VkAppTimings timings = { 0 };
+			res = runApp(vkGPU, &app, batch, &timings);
+			deleteApp(vkGPU, &app);
+			if (res != VK_SUCCESS) return res;
+			bandwidth->gpuTimestamps = timings.gpuTimestamps;
+			//read-only and write-only probes move the data once, the others read and write it
+			double rate = ((probe == VK_APP_PROBE_READ) || (probe == VK_APP_PROBE_WRITE) ? 1 : 2) * gigabytes / timings.median * 1000;
+			switch (probe) {
+			case VK_APP_PROBE_COPY:
+				bandwidth->copy = rate;
+				break;
+			case VK_APP_PROBE_READ:
+				bandwidth->read = rate;
+				break;
+			case VK_APP_PROBE_WRITE:
+				bandwidth->write = rate;
+				break;
+			case VK_APP_PROBE_STRIDED_READ:
+				bandwidth->stridedRead[i] = rate;
+				break;
+			case VK_APP_PROBE_STRIDED_WRITE:
+				bandwidth->stridedWrite[i] = rate;
+				break;
+			case VK_APP_PROBE_COPY_BUFFER:
+				bandwidth->copyBuffer = rate;
+				break;
+			}
+			if ((numStrides > 1) && ((bandwidth->worstStrided < 0) || (rate < bandwidth->worstStrided))) bandwidth->worstStrided = rate;
+		}
+	}
+	bandwidth->bestCopy = (bandwidth->copy > bandwidth->copyBuffer) ? bandwidth->copy : bandwidth->copyBuffer;
+	return res;
+}
+VkResult createScheduler(VkGPU* vkGPU, VkAppScheduler* scheduler) {
+	//create a command pool, command buffers and fences for each used compute queue
+	VkResult res = VK_SUCCESS;
+	if ((scheduler->numQueues == 0) || (scheduler->numQueues > vkGPU->numComputeQueues)) scheduler->numQueues = vkGPU->numComputeQueues;
+	scheduler->nextJobID = 1;
+	scheduler->lastQueue = scheduler->numQueues - 1;
+	for (uint32_t i = 0; i < scheduler->numQueues; i++) {
+		VkAppSchedulerQueue* queue = &scheduler->queues[i];
+		memset(queue, 0, sizeof(VkAppSchedulerQueue));
+		queue->queue = vkGPU->computeQueues[i];
+		queue->queueFamilyIndex = vkGPU->computeQueueFamilies[i];
+		VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+		commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		commandPoolCreateInfo.queueFamilyIndex = queue->queueFamilyIndex;
+		res = vkCreateCommandPool(vkGPU->device, &commandPoolCreateInfo, NULL, &queue->commandPool);
+		if (res != VK_SUCCESS) return res;
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+		commandBufferAllocateInfo.commandPool = queue->commandPool;
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocateInfo.commandBufferCount = VK_APP_MAX_QUEUE_JOBS;
+		res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, queue->commandBuffers);
+		if (res != VK_SUCCESS) return res;
+		for (uint32_t j = 0; j < VK_APP_MAX_QUEUE_JOBS; j++) {
+			VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+			res = vkCreateFence(vkGPU->device, &fenceCreateInfo, NULL, &queue->fences[j]);
+			if (res != VK_SUCCESS) return res;
+		}
+	}
+	return res;
+}
+VkResult retireJob(VkGPU* vkGPU, VkAppSchedulerQueue* queue, uint32_t slot, uint32_t wait) {
+	//free the slot if its job is finished, or after waiting for it
+	VkResult res = VK_SUCCESS;
+	if (wait) {
+		res = vkWaitForFences(vkGPU->device, 1, &queue->fences[slot], VK_TRUE, 100000000000);
+		if (res != VK_SUCCESS) return res;
+	}
+	else {
+		res = vkGetFenceStatus(vkGPU->device, queue->fences[slot]);
+		if (res == VK_NOT_READY) return VK_SUCCESS;
+		if (res != VK_SUCCESS) return res;
+	}
+	res = vkResetFences(vkGPU->device, 1, &queue->fences[slot]);
+	if (res != VK_SUCCESS) return res;
+	queue->jobIDs[slot] = 0;
+	queue->numJobs--;
+	return res;
+}
+VkResult submitApp(VkGPU* vkGPU, VkAppScheduler* scheduler, VkApplication* app, uint64_t* jobID) {
+	//queue loads are updated from the fences first, so finished jobs do not count. A queue with all slots taken waits for its oldest job
+	VkResult res = VK_SUCCESS;
+	for (uint32_t i = 0; i < scheduler->numQueues; i++) {
+		VkAppSchedulerQueue* queue = &scheduler->queues[i];
+		for (uint32_t j = 0; (j < VK_APP_MAX_QUEUE_JOBS) && (queue->numJobs > 0); j++) {
+			if (queue->jobIDs[j] == 0) continue;
+			res = retireJob(vkGPU, queue, j, 0);
+			if (res != VK_SUCCESS) return res;
+		}
+	}
+	uint32_t queueID = (scheduler->lastQueue + 1) % scheduler->numQueues;
+	for (uint32_t i = 1; i < scheduler->numQueues; i++) {
+		uint32_t candidate = (scheduler->lastQueue + 1 + i) % scheduler->numQueues;
+		if (scheduler->queues[candidate].numJobs < scheduler->queues[queueID].numJobs) queueID = candidate;
+	}
+	VkAppSchedulerQueue* queue = &scheduler->queues[queueID];
+	uint32_t slot = 0;
+	if (queue->numJobs == VK_APP_MAX_QUEUE_JOBS) {
+		for (uint32_t j = 1; j < VK_APP_MAX_QUEUE_JOBS; j++) {
+			if (queue->jobIDs[j] < queue->jobIDs[slot]) slot = j;
+		}
+		res = retireJob(vkGPU, queue, slot, 1);
+		if (res != VK_SUCCESS) return res;
+	}
+	else {
+		while (queue->jobIDs[slot] != 0) slot++;
+	}
+	//the command pool resets the command buffer when it is recorded again
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	res = vkBeginCommandBuffer(queue->commandBuffers[slot], &commandBufferBeginInfo);
+	if (res != VK_SUCCESS) return res;
+	appendApp(vkGPU, app, &queue->commandBuffers[slot]);
+	res = vkEndCommandBuffer(queue->commandBuffers[slot]);
+	if (res != VK_SUCCESS) return res;
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &queue->commandBuffers[slot];
+	res = vkQueueSubmit(queue->queue, 1, &submitInfo, queue->fences[slot]);
+	if (res != VK_SUCCESS) return res;
+	queue->jobIDs[slot] = scheduler->nextJobID;
+	queue->numJobs++;
+	queue->submittedJobs++;
+	scheduler->lastQueue = queueID;
+	jobID[0] = scheduler->nextJobID;
+	scheduler->nextJobID++;
+	return res;
+}
+VkResult waitJob(VkGPU* vkGPU, VkAppScheduler* scheduler, uint64_t jobID) {
+	//jobs that are not in flight have already been retired
+	VkResult res = VK_SUCCESS;
+	if (jobID >= scheduler->nextJobID) return VK_ERROR_INITIALIZATION_FAILED;
+	for (uint32_t i = 0; i < scheduler->numQueues; i++) {
+		for (uint32_t j = 0; j < VK_APP_MAX_QUEUE_JOBS; j++) {
+			if (scheduler->queues[i].jobIDs[j] == jobID) return retireJob(vkGPU, &scheduler->queues[i], j, 1);
+		}
+	}
+	return res;
+}
+VkResult waitScheduler(VkGPU* vkGPU, VkAppScheduler* scheduler) {
+	//wait for all jobs in flight
+	VkResult res = VK_SUCCESS;
+	for (uint32_t i = 0; i < scheduler->numQueues; i++) {
+		for (uint32_t j = 0; j < VK_APP_MAX_QUEUE_JOBS; j++) {
+			if (scheduler->queues[i].jobIDs[j] == 0) continue;
+			res = retireJob(vkGPU, &scheduler->queues[i], j, 1);
+			if (res != VK_SUCCESS) return res;
+		}
+	}
+	return res;
+}
+void deleteScheduler(VkGPU* vkGPU, VkAppScheduler* scheduler) {
+	//the jobs in flight are waited for before their command buffers are freed
+	waitScheduler(vkGPU, scheduler);
+	for (uint32_t i = 0; i < scheduler->numQueues; i++) {
+		VkAppSchedulerQueue* queue = &scheduler->queues[i];
+		for (uint32_t j = 0; j < VK_APP_MAX_QUEUE_JOBS; j++)
+			vkDestroyFence(vkGPU->device, queue->fences[j], NULL);
+		vkDestroyCommandPool(vkGPU->device, queue->commandPool, NULL);
+	}
+}
+VkAppPlanCacheEntry* findPlanCacheEntry(VkAppPlanCacheEntry* entries, uint32_t numEntries, VkAppPlanKey* key) {
+	//linear search, the cache holds a few tens of entries. Keys only consist of uint32_t values, so they are compared bytewise
+	for (uint32_t i = 0; i < numEntries; i++) {
+		if (memcmp(&entries[i].key, key, sizeof(VkAppPlanKey)) == 0) return &entries[i];
+	}
+	return NULL;
+}
+VkAppPlanCacheEntry* reservePlanCacheEntry(VkAppPlanCacheEntry* entries, uint32_t* numEntries, uint32_t capacity) {
+	//return a free entry, or the least recently used one if all entries are taken
+	if (numEntries[0] < capacity) {
+		numEntries[0]++;
+		return &entries[numEntries[0] - 1];
+	}
+	VkAppPlanCacheEntry* entry = &entries[0];
+	for (uint32_t i = 1; i < capacity; i++) {
+		if (entries[i].lastUse < entry->lastUse) entry = &entries[i];
+	}
+	return entry;
+}
+VkResult getCachedApp(VkGPU* vkGPU, VkAppPlanCache* cache, VkApplication* request, uint32_t shaderID, VkApplication** app) {
+	//shapes with few calls run on one dynamic plan per configuration, which is compiled once. After specializeThreshold calls with one shape, a plan specialized for it is compiled:
+	//its kernel has all sizes and strides folded, which pays off for hot shapes
+	VkResult res = VK_SUCCESS;
+	if (shaderID > 2) return VK_ERROR_INITIALIZATION_FAILED;
+	if (cache->capacity == 0) cache->capacity = 16;
+	if (cache->specializeThreshold == 0) cache->specializeThreshold = 8;
+	if (cache->plans == NULL) {
+		cache->plans = (VkAppPlanCacheEntry*)calloc(cache->capacity, sizeof(VkAppPlanCacheEntry));
+		cache->shapes = (VkAppPlanCacheEntry*)calloc(4 * cache->capacity, sizeof(VkAppPlanCacheEntry));
+		if ((cache->plans == NULL) || (cache->shapes == NULL)) return VK_ERROR_OUT_OF_HOST_MEMORY;
+	}
+	cache->clock++;
+	VkAppPlanKey key = { 0 };
+	key.dataType = request->dataType;
+	key.shaderID = shaderID;
+	key.coalescedMemory = request->coalescedMemory;
+	key.tileDim = request->tileDim;
+	key.blockRows = request->blockRows;
+	key.vectorWidth = request->vectorWidth;
+	key.tileOrder = request->tileOrder;
+	for (uint32_t i = 0; i < 3; i++)
+		key.size[i] = request->size[i];
+	key.strides[0] = request->inputRowStride;
+	key.strides[1] = request->inputMatrixStride;
+	key.strides[2] = request->outputRowStride;
+	key.strides[3] = request->outputMatrixStride;
+	//count the calls with this shape
+	VkAppPlanCacheEntry* shape = findPlanCacheEntry(cache->shapes, cache->numShapes, &key);
+	if (shape == NULL) {
+		shape = reservePlanCacheEntry(cache->shapes, &cache->numShapes, 4 * cache->capacity);
+		shape->key = key;
+		shape->calls = 0;
+	}
+	shape->calls++;
+	shape->lastUse = cache->clock;
+	//use the specialized plan if it exists or the shape is hot enough, the dynamic plan of the configuration otherwise
+	VkAppPlanCacheEntry* plan = findPlanCacheEntry(cache->plans, cache->numPlans, &key);
+	if ((plan == NULL) && (shape->calls < cache->specializeThreshold)) {
+		key.dynamicShape = 1;
+		memset(key.size, 0, sizeof(key.size));
+		memset(key.strides, 0, sizeof(key.strides));
+		plan = findPlanCacheEntry(cache->plans, cache->numPlans, &key);
+	}
+	if (plan == NULL) {
+		plan = reservePlanCacheEntry(cache->plans, &cache->numPlans, cache->capacity);
+		if (plan->app.pipeline != VK_NULL_HANDLE) {
+			deleteApp(vkGPU, &plan->app);
+			cache->evictions++;
+		}
+		memset(plan, 0, sizeof(VkAppPlanCacheEntry));
+		plan->key = key;
+		VkApplication* newApp = &plan->app;
+		newApp->dataType = request->dataType;
+		newApp->coalescedMemory = request->coalescedMemory;
+		newApp->tileDim = request->tileDim;
+		newApp->blockRows = request->blockRows;
+		newApp->vectorWidth = request->vectorWidth;
+		newApp->tileOrder = request->tileOrder;
+		newApp->dynamicShape = key.dynamicShape;
+		for (uint32_t i = 0; i < 3; i++)
+			newApp->size[i] = request->size[i];
+		newApp->inputRowStride = request->inputRowStride;
+		newApp->inputMatrixStride = request->inputMatrixStride;
+		newApp->outputRowStride = request->outputRowStride;
+		newApp->outputMatrixStride = request->outputMatrixStride;
+		newApp->inputBufferSize = request->inputBufferSize;
+		newApp->inputBuffer = request->inputBuffer;
+		newApp->inputBufferDeviceMemory = request->inputBufferDeviceMemory;
+		newApp->outputBufferSize = request->outputBufferSize;
+		newApp->outputBuffer = request->outputBuffer;
+		newApp->outputBufferDeviceMemory = request->outputBufferDeviceMemory;
+		double createStart = getWallTime();
+		res = createApp(vkGPU, newApp, shaderID);
+		cache->createTime += getWallTime() - createStart;
+		if (res != VK_SUCCESS) {
+			//the entry is released, so it is not found by the next lookups
+			deleteApp(vkGPU, newApp);
+			memset(plan, 0, sizeof(VkAppPlanCacheEntry));
+			cache->numPlans--;
+			if (plan != &cache->plans[cache->numPlans]) {
+				plan[0] = cache->plans[cache->numPlans];
+				memset(&cache->plans[cache->numPlans], 0, sizeof(VkAppPlanCacheEntry));
+			}
+			return res;
+		}
+		if (key.dynamicShape)
+			cache->dynamicPlans++;
+		else
+			cache->specializedPlans++;
+	}
+	else {
+		cache->hits++;
+		if (plan->key.dynamicShape) {
+			//move the dynamic plan to the requested shape
+			for (uint32_t i = 0; i < 3; i++)
+				plan->app.size[i] = request->size[i];
+			plan->app.inputRowStride = request->inputRowStride;
+			plan->app.inputMatrixStride = request->inputMatrixStride;
+			plan->app.outputRowStride = request->outputRowStride;
+			plan->app.outputMatrixStride = request->outputMatrixStride;
+			res = reshapeApp(vkGPU, &plan->app);
+			if (res != VK_SUCCESS) return res;
+		}
+		if ((plan->app.inputBuffer[0] != request->inputBuffer[0]) || (plan->app.outputBuffer[0] != request->outputBuffer[0]) || (plan->app.inputBufferSize != request->inputBufferSize) || (plan->app.outputBufferSize != request->outputBufferSize)) {
+			res = bindApp(vkGPU, &plan->app, request->inputBuffer, request->inputBufferSize, request->outputBuffer, request->outputBufferSize);
+			if (res != VK_SUCCESS) return res;
+		}
+	}
+	plan->lastUse = cache->clock;
+	app[0] = &plan->app;
+	return res;
+}
+void deletePlanCache(VkGPU* vkGPU, VkAppPlanCache* cache) {
+	//destroy all plans of the cache and its counters
+	for (uint32_t i = 0; i < cache->numPlans; i++)
+		deleteApp(vkGPU, &cache->plans[i].app);
+	free(cache->plans);
+	free(cache->shapes);
+	cache->plans = NULL;
+	cache->shapes = NULL;
+	cache->numPlans = 0;
+	cache->numShapes = 0;
+}
+VkResult findMemoryType(VkGPU* vkGPU, uint32_t memoryTypeBits, VkMemoryPropertyFlags properties, uint32_t* memoryTypeIndex) {
+	//find memory with specified properties. Types with fewer additional properties are preferred, so staging buffers do not take the small device-local host-visible heap of discrete GPUs
+	VkPhysicalDeviceMemoryProperties* memoryProperties = &vkGPU->physicalDeviceMemoryProperties;
+	uint32_t bestExtraFlags = 33;
+	for (uint32_t i = 0; i < memoryProperties->memoryTypeCount; ++i) {
+		if ((memoryTypeBits & (1 << i)) && ((memoryProperties->memoryTypes[i].propertyFlags & properties) == properties))
+		{
+			uint32_t extraFlags = 0;
+			for (VkMemoryPropertyFlags flags = memoryProperties->memoryTypes[i].propertyFlags & ~properties; flags; flags &= flags - 1)
+				extraFlags++;
+			if (extraFlags < bestExtraFlags) {
+				memoryTypeIndex[0] = i;
+				bestExtraFlags = extraFlags;
+			}
+		}
+	}
+	return (bestExtraFlags < 33) ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+}
+VkResult allocateMemoryBlock(VkGPU* vkGPU, uint32_t memoryTypeIndex, VkDeviceSize slotSize, uint32_t* block) {
+	//allocate a new block for the size class, or reuse an empty block of another size class of the same memory type
+	VkResult res = VK_SUCCESS;
+	for (uint32_t i = 0; i < vkGPU->numMemoryBlocks; i++) {
+		VkAppMemoryBlock* emptyBlock = &vkGPU->memoryBlocks[i];
+		if ((emptyBlock->memoryTypeIndex == memoryTypeIndex) && (emptyBlock->usedSlots == 0)) {
+			free(emptyBlock->slotUsed);
+			emptyBlock->slotSize = slotSize;
+			emptyBlock->numSlots = (uint32_t)(VK_APP_MEMORY_BLOCK_SIZE / slotSize);
+			emptyBlock->slotUsed = (uint8_t*)calloc(emptyBlock->numSlots, sizeof(uint8_t));
+			if (emptyBlock->slotUsed == NULL) {
+				//the block stays empty with no slots, so it is never selected for a size class
+				emptyBlock->numSlots = 0;
+				return VK_ERROR_OUT_OF_HOST_MEMORY;
+			}
+			block[0] = i;
+			return res;
+		}
+	}
+	VkAppMemoryBlock* memoryBlocks = (VkAppMemoryBlock*)realloc(vkGPU->memoryBlocks, (vkGPU->numMemoryBlocks + 1) * sizeof(VkAppMemoryBlock));
+	if (memoryBlocks == NULL) return VK_ERROR_OUT_OF_HOST_MEMORY;
+	vkGPU->memoryBlocks = memoryBlocks;
+	VkAppMemoryBlock* newBlock = &vkGPU->memoryBlocks[vkGPU->numMemoryBlocks];
+	memset(newBlock, 0, sizeof(VkAppMemoryBlock));
+	VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+	memoryAllocateInfo.allocationSize = VK_APP_MEMORY_BLOCK_SIZE;
+	memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+	res = vkAllocateMemory(vkGPU->device, &memoryAllocateInfo, NULL, &newBlock->memory);
+	if (res != VK_SUCCESS) return res;
+	vkGPU->memoryAllocationCount++;
+	newBlock->memoryTypeIndex = memoryTypeIndex;
+	newBlock->slotSize = slotSize;
+	newBlock->numSlots = (uint32_t)(VK_APP_MEMORY_BLOCK_SIZE / slotSize);
+	newBlock->slotUsed = (uint8_t*)calloc(newBlock->numSlots, sizeof(uint8_t));
+	if (newBlock->slotUsed == NULL) {
+		vkFreeMemory(vkGPU->device, newBlock->memory, NULL);
+		return VK_ERROR_OUT_OF_HOST_MEMORY;
+	}
+	block[0] = vkGPU->numMemoryBlocks;
+	vkGPU->numMemoryBlocks++;
+	return res;
+}
+void destroyFailedBuffer(VkGPU* vkGPU, VkBuffer* buffer, VkDeviceMemory* deviceMemory) {
+	//release a buffer of allocateFFTBuffer that failed before it was recorded: the buffer and its dedicated memory, if it was already allocated
+	vkDestroyBuffer(vkGPU->device, buffer[0], NULL);
+	if (deviceMemory[0] != VK_NULL_HANDLE) vkFreeMemory(vkGPU->device, deviceMemory[0], NULL);
+	buffer[0] = VK_NULL_HANDLE;
+	deviceMemory[0] = VK_NULL_HANDLE;
+}
+VkResult allocateFFTBuffer(VkGPU* vkGPU, VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags, VkDeviceSize size) {
+	//allocate the buffer used by the GPU with specified properties. Device-local buffers up to a quarter of the block are placed in a free slot of a block of their size class,
+	//the slot size is a power of two not smaller than the required alignment, so slot offsets are always aligned
+	VkResult res = VK_SUCCESS;
+	double allocationStart = getWallTime();
+	VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+	//with a dedicated transfer queue or several compute families, buffers are shared by all queue families, so they can be used by plans on any queue right after a transfer without ownership transfers
+	bufferCreateInfo.sharingMode = (vkGPU->numQueueFamilies > 1) ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+	bufferCreateInfo.queueFamilyIndexCount = vkGPU->numQueueFamilies;
+	bufferCreateInfo.pQueueFamilyIndices = vkGPU->queueFamilies;
+	bufferCreateInfo.size = size;
+	bufferCreateInfo.usage = usageFlags;
+	res = vkCreateBuffer(vkGPU->device, &bufferCreateInfo, NULL, buffer);
+	if (res != VK_SUCCESS) return res;
+	deviceMemory[0] = VK_NULL_HANDLE;
+	VkMemoryRequirements memoryRequirements = { 0 };
+	vkGetBufferMemoryRequirements(vkGPU->device, buffer[0], &memoryRequirements);
+	uint32_t memoryTypeIndex = 0;
+	res = findMemoryType(vkGPU, memoryRequirements.memoryTypeBits, propertyFlags, &memoryTypeIndex);
+	if (res != VK_SUCCESS) {
+		destroyFailedBuffer(vkGPU, buffer, deviceMemory);
+		return res;
+	}
+	if (vkGPU->numBufferAllocations == vkGPU->maxBufferAllocations) {
+		uint32_t maxBufferAllocations = (vkGPU->maxBufferAllocations) ? 2 * vkGPU->maxBufferAllocations : 64;
+		VkAppBufferAllocation* bufferAllocations = (VkAppBufferAllocation*)realloc(vkGPU->bufferAllocations, maxBufferAllocations * sizeof(VkAppBufferAllocation));
+		if (bufferAllocations == NULL) {
+			destroyFailedBuffer(vkGPU, buffer, deviceMemory);
+			return VK_ERROR_OUT_OF_HOST_MEMORY;
+		}
+		vkGPU->bufferAllocations = bufferAllocations;
+		vkGPU->maxBufferAllocations = maxBufferAllocations;
+	}
+	VkAppBufferAllocation* allocation = &vkGPU->bufferAllocations[vkGPU->numBufferAllocations];
+	memset(allocation, 0, sizeof(VkAppBufferAllocation));
+	allocation->buffer = buffer[0];
+	VkDeviceSize slotSize = VK_APP_MIN_SIZE_CLASS;
+	while ((slotSize < memoryRequirements.size) || (slotSize < memoryRequirements.alignment))
+		slotSize *= 2;
+	uint32_t dedicated = (vkGPU->dedicatedMemory) || (propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) || (slotSize > VK_APP_MEMORY_BLOCK_SIZE / 4);
+	if (!dedicated) {
+		//first free slot in a block of the size class, a new block if all of them are full
+		uint32_t block = vkGPU->numMemoryBlocks;
+		uint32_t slot = 0;
+		for (uint32_t i = 0; (i < vkGPU->numMemoryBlocks) && (block == vkGPU->numMemoryBlocks); i++) {
+			VkAppMemoryBlock* memoryBlock = &vkGPU->memoryBlocks[i];
+			if ((memoryBlock->memoryTypeIndex != memoryTypeIndex) || (memoryBlock->slotSize != slotSize) || (memoryBlock->usedSlots == memoryBlock->numSlots)) continue;
+			for (slot = 0; memoryBlock->slotUsed[slot]; slot++);
+			block = i;
+		}
+		if (block == vkGPU->numMemoryBlocks) {
+			//a new block may not fit in a small or fragmented heap while the buffer alone still does, so the buffer gets its own allocation then
+			res = allocateMemoryBlock(vkGPU, memoryTypeIndex, slotSize, &block);
+			if (res != VK_SUCCESS) dedicated = 1;
+			slot = 0;
+		}
+		if (!dedicated) {
+			VkAppMemoryBlock* memoryBlock = &vkGPU->memoryBlocks[block];
+			res = vkBindBufferMemory(vkGPU->device, buffer[0], memoryBlock->memory, slot * slotSize);
+			if (res != VK_SUCCESS) {
+				//the slot is not taken yet and the block memory is not freed, only the buffer is destroyed
+				vkDestroyBuffer(vkGPU->device, buffer[0], NULL);
+				buffer[0] = VK_NULL_HANDLE;
+				return res;
+			}
+			memoryBlock->slotUsed[slot] = 1;
+			memoryBlock->usedSlots++;
+			allocation->block = block;
+			allocation->slot = slot;
+			deviceMemory[0] = memoryBlock->memory;
+		}
+	}
+	if (dedicated) {
+		VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+		memoryAllocateInfo.allocationSize = memoryRequirements.size;
+		memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+		res = vkAllocateMemory(vkGPU->device, &memoryAllocateInfo, NULL, deviceMemory);
+		if (res != VK_SUCCESS) {
+			destroyFailedBuffer(vkGPU, buffer, deviceMemory);
+			return res;
+		}
+		vkGPU->memoryAllocationCount++;
+		allocation->memory = deviceMemory[0];
+		res = vkBindBufferMemory(vkGPU->device, buffer[0], deviceMemory[0], 0);
+		if (res != VK_SUCCESS) {
+			destroyFailedBuffer(vkGPU, buffer, deviceMemory);
+			return res;
+		}
+	}
+	vkGPU->numBufferAllocations++;
+	vkGPU->bufferAllocationCount++;
+	vkGPU->memoryAllocationTime += getWallTime() - allocationStart;
+	return res;
+}
+void freeFFTBuffer(VkGPU* vkGPU, VkBuffer* buffer, VkDeviceMemory* deviceMemory) {
+	//destroy the buffer and release its slot or its dedicated memory. Buffers not made by allocateFFTBuffer (imported host memory) own their memory and are destroyed as they are
+	uint32_t found = 0;
+	for (uint32_t i = 0; i < vkGPU->numBufferAllocations; i++) {
+		VkAppBufferAllocation* allocation = &vkGPU->bufferAllocations[i];
+		if (allocation->buffer != buffer[0]) continue;
+		vkDestroyBuffer(vkGPU->device, buffer[0], NULL);
+		if (allocation->memory != VK_NULL_HANDLE) {
+			vkFreeMemory(vkGPU->device, allocation->memory, NULL);
+		}
+		else {
+			vkGPU->memoryBlocks[allocation->block].slotUsed[allocation->slot] = 0;
+			vkGPU->memoryBlocks[allocation->block].usedSlots--;
+		}
+		vkGPU->bufferAllocations[i] = vkGPU->bufferAllocations[vkGPU->numBufferAllocations - 1];
+		vkGPU->numBufferAllocations--;
+		found = 1;
+		break;
+	}
+	if ((!found) && (buffer[0] != VK_NULL_HANDLE)) {
+		vkDestroyBuffer(vkGPU->device, buffer[0], NULL);
+		if (deviceMemory[0] != VK_NULL_HANDLE) vkFreeMemory(vkGPU->device, deviceMemory[0], NULL);
+	}
+	buffer[0] = VK_NULL_HANDLE;
+	deviceMemory[0] = VK_NULL_HANDLE;
+}
+VkResult retireTransfer(VkGPU* vkGPU) {
+	//wait for the oldest transfer in flight and release its region of the staging ring. Downloads are copied to the host at this point
+	VkResult res = VK_SUCCESS;
+	VkAppTransfer* transfer = &vkGPU->transfers[(vkGPU->retiredTransferID + 1) % VK_APP_MAX_TRANSFERS];
+	res = vkWaitForFences(vkGPU->device, 1, &transfer->fence, VK_TRUE, 100000000000);
+	if (res != VK_SUCCESS) return res;
+	res = vkResetFences(vkGPU->device, 1, &transfer->fence);
+	if (res != VK_SUCCESS) return res;
+	if (transfer->hostData != NULL)
+		memcpy(transfer->hostData, (char*)vkGPU->stagingData + transfer->stagingOffset, transfer->size);
+	transfer->id = 0;
+	transfer->hostData = NULL;
+	vkGPU->retiredTransferID++;
+	return res;
+}
+VkResult reserveTransfer(VkGPU* vkGPU, VkDeviceSize size, VkAppTransfer** transfer) {
+	//take the next transfer slot and a contiguous region of the staging ring, waiting for the oldest transfers until both are free. The reservation is committed by submitTransfer once the copy is submitted
+	VkResult res = VK_SUCCESS;
+	if ((size == 0) || (size > vkGPU->stagingBufferSize)) return VK_ERROR_INITIALIZATION_FAILED;
+	while (vkGPU->nextTransferID - vkGPU->retiredTransferID > VK_APP_MAX_TRANSFERS) {
+		res = retireTransfer(vkGPU);
+		if (res != VK_SUCCESS) return res;
+	}
+	VkDeviceSize offset = 0;
+	for (;;) {
+		if (vkGPU->nextTransferID - vkGPU->retiredTransferID == 1) {
+			//nothing in flight, the whole ring is free
+			offset = 0;
+			break;
+		}
+		//regions in flight span from the oldest transfer to the head, possibly wrapping around the end of the ring
+		VkDeviceSize tail = vkGPU->transfers[(vkGPU->retiredTransferID + 1) % VK_APP_MAX_TRANSFERS].stagingOffset;
+		VkDeviceSize head = vkGPU->stagingHead;
+		if (head > tail) {
+			if (vkGPU->stagingBufferSize - head >= size) {
+				offset = head;
+				break;
+			}
+			if (tail >= size) {
+				offset = 0;
+				break;
+			}
+		}
+		else if ((head < tail) && (tail - head >= size)) {
+			offset = head;
+			break;
+		}
+		res = retireTransfer(vkGPU);
+		if (res != VK_SUCCESS) return res;
+	}
+	transfer[0] = &vkGPU->transfers[vkGPU->nextTransferID % VK_APP_MAX_TRANSFERS];
+	transfer[0]->id = vkGPU->nextTransferID;
+	transfer[0]->stagingOffset = offset;
+	transfer[0]->size = size;
+	transfer[0]->hostData = NULL;
+	return res;
+}
+VkResult submitTransfer(VkGPU* vkGPU, VkAppTransfer* transfer, VkBuffer srcBuffer, VkDeviceSize srcOffset, VkBuffer dstBuffer, VkDeviceSize dstOffset) {
+	//record the copy in the command buffer of the transfer slot and submit it to the transfer queue. The slot and the staging region are only taken after a successful submit,
+	//otherwise the fence of the slot would never signal and every later retireTransfer would wait for it
+	VkResult res = VK_SUCCESS;
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	res = vkBeginCommandBuffer(transfer->commandBuffer, &commandBufferBeginInfo);
+	if (res != VK_SUCCESS) goto release;
+	VkBufferCopy copyRegion = { 0 };
+	copyRegion.srcOffset = srcOffset;
+	copyRegion.dstOffset = dstOffset;
+	copyRegion.size = transfer->size;
+	vkCmdCopyBuffer(transfer->commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+	if (transfer->hostData != NULL) {
+		//make the download visible to the host after the fence
+		VkMemoryBarrier memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(transfer->commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, NULL, 0, NULL);
+	}
+	res = vkEndCommandBuffer(transfer->commandBuffer);
+	if (res != VK_SUCCESS) goto release;
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &transfer->commandBuffer;
+	res = vkQueueSubmit(vkGPU->transferQueue, 1, &submitInfo, transfer->fence);
+	if (res != VK_SUCCESS) goto release;
+	vkGPU->stagingHead = transfer->stagingOffset + transfer->size;
+	vkGPU->nextTransferID++;
+	return res;
+release:
+	transfer->id = 0;
+	transfer->hostData = NULL;
+	return res;
+}
+VkResult uploadDataAsync(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferOffset, VkDeviceSize size, uint64_t* transferID) {
+	//copy the host data to the staging ring and submit its copy to the buffer, without waiting for it
+	VkResult res = VK_SUCCESS;
+	VkAppTransfer* transfer = NULL;
+	res = reserveTransfer(vkGPU, size, &transfer);
+	if (res != VK_SUCCESS) return res;
+	memcpy((char*)vkGPU->stagingData + transfer->stagingOffset, arr, size);
+	uint64_t id = transfer->id;
+	res = submitTransfer(vkGPU, transfer, vkGPU->stagingBuffer, transfer->stagingOffset, buffer[0], bufferOffset);
+	if (res != VK_SUCCESS) return res;
+	transferID[0] = id;
+	return res;
+}
+VkResult downloadDataAsync(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferOffset, VkDeviceSize size, uint64_t* transferID) {
+	//submit the copy of the buffer to the staging ring, without waiting for it. The data is copied to arr by waitTransfer
+	VkResult res = VK_SUCCESS;
+	VkAppTransfer* transfer = NULL;
+	res = reserveTransfer(vkGPU, size, &transfer);
+	if (res != VK_SUCCESS) return res;
+	transfer->hostData = arr;
+	uint64_t id = transfer->id;
+	res = submitTransfer(vkGPU, transfer, buffer[0], bufferOffset, vkGPU->stagingBuffer, transfer->stagingOffset);
+	if (res != VK_SUCCESS) return res;
+	transferID[0] = id;
+	return res;
+}
+VkResult waitTransfer(VkGPU* vkGPU, uint64_t transferID) {
+	//transfers finish in order, so all transfers up to transferID are retired
+	VkResult res = VK_SUCCESS;
+	if (transferID >= vkGPU->nextTransferID) return VK_ERROR_INITIALIZATION_FAILED;
+	while (vkGPU->retiredTransferID < transferID) {
+		res = retireTransfer(vkGPU);
+		if (res != VK_SUCCESS) return res;
+	}
+	return res;
+}
+VkResult transferDataFromCPU(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
+	//a function that transfers data from the CPU to the GPU through the staging ring, because the GPU memory is not host-coherent. Data larger than the ring is sent in chunks of half of it, so two chunks are in flight
+	VkResult res = VK_SUCCESS;
+	VkDeviceSize chunkSize = vkGPU->stagingBufferSize / 2;
+	uint64_t transferID = 0;
+	for (VkDeviceSize offset = 0; offset < bufferSize; offset += chunkSize) {
+		VkDeviceSize size = (bufferSize - offset < chunkSize) ? bufferSize - offset : chunkSize;
+		res = uploadDataAsync(vkGPU, (char*)arr + offset, buffer, offset, size, &transferID);
+		if (res != VK_SUCCESS) return res;
+	}
+	if (transferID) res = waitTransfer(vkGPU, transferID);
+	return res;
+}
+VkResult transferDataToCPU(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
+	//a function that transfers data from the GPU to the CPU through the staging ring, because the GPU memory is not host-coherent
+	VkResult res = VK_SUCCESS;
+	VkDeviceSize chunkSize = vkGPU->stagingBufferSize / 2;
+	uint64_t transferID = 0;
+	for (VkDeviceSize offset = 0; offset < bufferSize; offset += chunkSize) {
+		VkDeviceSize size = (bufferSize - offset < chunkSize) ? bufferSize - offset : chunkSize;
+		res = downloadDataAsync(vkGPU, (char*)arr + offset, buffer, offset, size, &transferID);
+		if (res != VK_SUCCESS) return res;
+	}
+	if (transferID) res = waitTransfer(vkGPU, transferID);
+	return res;
+}
+VkResult importHostBuffer(VkGPU* vkGPU, void* hostPointer, VkDeviceSize size, VkBuffer* buffer, VkDeviceMemory* deviceMemory) {
+	//import the host allocation as a buffer. The imported memory covers whole pages of the allocation, so the import size is rounded up to minImportedHostPointerAlignment
+	VkResult res = VK_SUCCESS;
+	if ((!vkGPU->externalMemoryHost) || ((uint64_t)(uintptr_t)hostPointer % vkGPU->minImportedHostPointerAlignment)) return VK_ERROR_FEATURE_NOT_PRESENT;
+	VkDeviceSize importSize = (size + vkGPU->minImportedHostPointerAlignment - 1) / vkGPU->minImportedHostPointerAlignment * vkGPU->minImportedHostPointerAlignment;
+	VkMemoryHostPointerPropertiesEXT hostPointerProperties = { VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT };
+	res = vkGPU->getMemoryHostPointerProperties(vkGPU->device, VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT, hostPointer, &hostPointerProperties);
+	if (res != VK_SUCCESS) return res;
+	VkExternalMemoryBufferCreateInfo externalMemoryBufferCreateInfo = { VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO };
+	externalMemoryBufferCreateInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+	VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+	bufferCreateInfo.pNext = &externalMemoryBufferCreateInfo;
+	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	bufferCreateInfo.queueFamilyIndexCount = 1;
+	bufferCreateInfo.pQueueFamilyIndices = &vkGPU->queueFamilyIndex;
+	bufferCreateInfo.size = size;
+	bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+	res = vkCreateBuffer(vkGPU->device, &bufferCreateInfo, NULL, buffer);
+	if (res != VK_SUCCESS) return res;
+	VkMemoryRequirements memoryRequirements = { 0 };
+	vkGetBufferMemoryRequirements(vkGPU->device, buffer[0], &memoryRequirements);
+	uint32_t memoryTypeIndex = 0;
+	res = findMemoryType(vkGPU, memoryRequirements.memoryTypeBits & hostPointerProperties.memoryTypeBits, 0, &memoryTypeIndex);
+	if ((res == VK_SUCCESS) && (memoryRequirements.size > importSize)) res = VK_ERROR_FEATURE_NOT_PRESENT;
+	if (res != VK_SUCCESS) {
+		vkDestroyBuffer(vkGPU->device, buffer[0], NULL);
+		buffer[0] = VK_NULL_HANDLE;
+		return res;
+	}
+	VkImportMemoryHostPointerInfoEXT importMemoryHostPointerInfo = { VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT };
+	importMemoryHostPointerInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+	importMemoryHostPointerInfo.pHostPointer = hostPointer;
+	VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+	memoryAllocateInfo.pNext = &importMemoryHostPointerInfo;
+	memoryAllocateInfo.allocationSize = importSize;
+	memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+	res = vkAllocateMemory(vkGPU->device, &memoryAllocateInfo, NULL, deviceMemory);
+	if (res != VK_SUCCESS) {
+		vkDestroyBuffer(vkGPU->device, buffer[0], NULL);
+		buffer[0] = VK_NULL_HANDLE;
+		deviceMemory[0] = VK_NULL_HANDLE;
+		return res;
+	}
+	res = vkBindBufferMemory(vkGPU->device, buffer[0], deviceMemory[0], 0);
+	if (res != VK_SUCCESS) {
+		vkDestroyBuffer(vkGPU->device, buffer[0], NULL);
+		vkFreeMemory(vkGPU->device, deviceMemory[0], NULL);
+		buffer[0] = VK_NULL_HANDLE;
+		deviceMemory[0] = VK_NULL_HANDLE;
+	}
+	return res;
+}
+VkResult submitHostApp(VkGPU* vkGPU, VkApplication* app) {
+	//run the plan on buffers that are accessed by the host and make its output visible to the host after the fence
+	VkResult res = VK_SUCCESS;
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = vkGPU->commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+	uint32_t submitted = 0;
+	res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &commandBuffer);
+	if (res != VK_SUCCESS) return res;
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	res = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	if (res != VK_SUCCESS) goto cleanup;
+	appendApp(vkGPU, app, &commandBuffer);
+	VkMemoryBarrier memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+	memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, NULL, 0, NULL);
+	res = vkEndCommandBuffer(commandBuffer);
+	if (res != VK_SUCCESS) goto cleanup;
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	res = vkQueueSubmit(vkGPU->queue, 1, &submitInfo, vkGPU->fence);
+	if (res != VK_SUCCESS) goto cleanup;
+	submitted = 1;
+	res = vkWaitForFences(vkGPU->device, 1, &vkGPU->fence, VK_TRUE, 100000000000);
+	if (res != VK_SUCCESS) goto cleanup;
+	submitted = 0;
+	res = vkResetFences(vkGPU->device, 1, &vkGPU->fence);
+cleanup:
+	//a failed wait leaves the command buffer pending, it can only be freed once the queue is idle
+	if (submitted) {
+		vkQueueWaitIdle(vkGPU->queue);
+		vkResetFences(vkGPU->device, 1, &vkGPU->fence);
+	}
+	vkFreeCommandBuffers(vkGPU->device, vkGPU->commandPool, 1, &commandBuffer);
+	return res;
+}
+VkResult hostApp(VkGPU* vkGPU, VkApplication* app, void* input, void* output, uint32_t allowZeroCopy, uint32_t* hostPath) {
+	//transpose host arrays with the fewest copies the device allows: imported host memory (no copies), host-visible device-local memory on integrated GPUs (one host copy each way)
+	//and the staging ring (two copies each way). On discrete GPUs host-visible device-local memory is a PCIe window with uncached host reads, so it is not used there
+	VkResult res = VK_SUCCESS;
+	if (app->shaderID > 2) return VK_ERROR_INITIALIZATION_FAILED;
+	VkBuffer* boundInputBuffer = app->inputBuffer;
+	VkDeviceSize boundInputBufferSize = app->inputBufferSize;
+	VkBuffer* boundOutputBuffer = app->outputBuffer;
+	VkDeviceSize boundOutputBufferSize = app->outputBufferSize;
+	//freeFFTBuffer releases both the allocated and the imported buffers, the imported ones own their memory
+	VkBuffer inputBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory inputBufferDeviceMemory = VK_NULL_HANDLE;
+	VkBuffer outputBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory outputBufferDeviceMemory = VK_NULL_HANDLE;
+	uint32_t bound = 0;
+	hostPath[0] = VK_APP_HOST_PATH_STAGED;
+	if (allowZeroCopy && vkGPU->externalMemoryHost) {
+		res = importHostBuffer(vkGPU, input, boundInputBufferSize, &inputBuffer, &inputBufferDeviceMemory);
+		if (res == VK_SUCCESS) {
+			res = importHostBuffer(vkGPU, output, boundOutputBufferSize, &outputBuffer, &outputBufferDeviceMemory);
+			if (res == VK_SUCCESS)
+				hostPath[0] = VK_APP_HOST_PATH_IMPORTED;
+			else
+				freeFFTBuffer(vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+		}
+	}
+	if (allowZeroCopy && (hostPath[0] == VK_APP_HOST_PATH_STAGED) && ((vkGPU->physicalDeviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU) || (vkGPU->physicalDeviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU))) {
+		VkMemoryPropertyFlags propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		res = allocateFFTBuffer(vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, propertyFlags, boundInputBufferSize);
+		if (res == VK_SUCCESS) {
+			res = allocateFFTBuffer(vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, propertyFlags, boundOutputBufferSize);
+			if (res == VK_SUCCESS)
+				hostPath[0] = VK_APP_HOST_PATH_MAPPED;
+			else
+				freeFFTBuffer(vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+		}
+	}
+	if (hostPath[0] == VK_APP_HOST_PATH_STAGED) {
+		res = allocateFFTBuffer(vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, boundInputBufferSize);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = allocateFFTBuffer(vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, boundOutputBufferSize);
+		if (res != VK_SUCCESS) goto cleanup;
+	}
+	res = bindApp(vkGPU, app, &inputBuffer, boundInputBufferSize, &outputBuffer, boundOutputBufferSize);
+	if (res != VK_SUCCESS) goto cleanup;
+	bound = 1;
+	if (hostPath[0] == VK_APP_HOST_PATH_IMPORTED) {
+		res = submitHostApp(vkGPU, app);
+		if (res != VK_SUCCESS) goto cleanup;
+	}
+	else if (hostPath[0] == VK_APP_HOST_PATH_MAPPED) {
+		void* data;
+		res = vkMapMemory(vkGPU->device, inputBufferDeviceMemory, 0, boundInputBufferSize, 0, &data);
+		if (res != VK_SUCCESS) goto cleanup;
+		memcpy(data, input, boundInputBufferSize);
+		vkUnmapMemory(vkGPU->device, inputBufferDeviceMemory);
+		res = submitHostApp(vkGPU, app);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = vkMapMemory(vkGPU->device, outputBufferDeviceMemory, 0, boundOutputBufferSize, 0, &data);
+		if (res != VK_SUCCESS) goto cleanup;
+		memcpy(output, data, boundOutputBufferSize);
+		vkUnmapMemory(vkGPU->device, outputBufferDeviceMemory);
+	}
+	else {
+		res = transferDataFromCPU(vkGPU, input, &inputBuffer, boundInputBufferSize);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = executeApp(vkGPU, app);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = transferDataToCPU(vkGPU, output, &outputBuffer, boundOutputBufferSize);
+		if (res != VK_SUCCESS) goto cleanup;
+	}
+cleanup:
+	//after an error the buffers may still be used by submitted commands
+	if (res != VK_SUCCESS) vkDeviceWaitIdle(vkGPU->device);
+	freeFFTBuffer(vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+	freeFFTBuffer(vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+	if (bound) {
+		//the descriptor set of the released buffers is not used again, the plan records its command buffer again for the previous buffers
+		VkResult bindRes = bindApp(vkGPU, app, boundInputBuffer, boundInputBufferSize, boundOutputBuffer, boundOutputBufferSize);
+		if (res == VK_SUCCESS) res = bindRes;
+	}
+	return res;
+}
+typedef struct {
+	//staging buffers stay mapped for the whole stream, device buffers hold one input panel and its transposition
+	VkBuffer uploadBuffer;
+	VkDeviceMemory uploadBufferDeviceMemory;
+	void* uploadData;
+	VkBuffer downloadBuffer;
+	VkDeviceMemory downloadBufferDeviceMemory;
+	void* downloadData;
+	VkBuffer inputBuffer;
+	VkDeviceMemory inputBufferDeviceMemory;
+	VkBuffer outputBuffer;
+	VkDeviceMemory outputBufferDeviceMemory;
+	//copies are recorded for the transfer queue, the transposition for the compute queue. The semaphores chain the three submits of a panel, the fence signals its download
+	VkCommandBuffer uploadCommandBuffer;
+	VkCommandBuffer computeCommandBuffer;
+	VkCommandBuffer downloadCommandBuffer;
+	VkSemaphore uploaded;
+	VkSemaphore transposed;
+	VkFence fence;
+	//panel in flight in this slot, -1 - slot is free
+	int64_t panel;
+	uint32_t panelRows;
+} VkAppStreamSlot;
+void scatterPanel(VkApplication* app, VkAppStreamSlot* slot, uint32_t panelRows, void* output) {
+	//the transposed panel has panelRows columns and size[0] rows, it is a column panel of the output with size[1] columns
+	uint64_t elementSize = dataTypes[app->dataType].size;
+	uint64_t panelStart = (uint64_t)slot->panel * panelRows;
+	for (uint64_t i = 0; i < app->size[0]; i++) {
+		memcpy((char*)output + (i * app->size[1] + panelStart) * elementSize, (char*)slot->downloadData + i * slot->panelRows * elementSize, slot->panelRows * elementSize);
+	}
+}
+VkResult submitStreamPanel(VkGPU* vkGPU, VkApplication* plan, VkAppStreamSlot* slot, VkDeviceSize copySize) {
+	//record and submit the upload and the download of a panel on the transfer queue and its transposition on the compute queue. Buffers are shared by both queue families, so the semaphores are the only synchronization between the queues
+	VkResult res = VK_SUCCESS;
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	VkBufferCopy copyRegion = { 0 };
+	copyRegion.size = copySize;
+	res = vkBeginCommandBuffer(slot->uploadCommandBuffer, &commandBufferBeginInfo);
+	if (res != VK_SUCCESS) return res;
+	vkCmdCopyBuffer(slot->uploadCommandBuffer, slot->uploadBuffer, slot->inputBuffer, 1, &copyRegion);
+	res = vkEndCommandBuffer(slot->uploadCommandBuffer);
+	if (res != VK_SUCCESS) return res;
+	res = vkBeginCommandBuffer(slot->computeCommandBuffer, &commandBufferBeginInfo);
+	if (res != VK_SUCCESS) return res;
+	appendApp(vkGPU, plan, &slot->computeCommandBuffer);
+	res = vkEndCommandBuffer(slot->computeCommandBuffer);
+	if (res != VK_SUCCESS) return res;
+	res = vkBeginCommandBuffer(slot->downloadCommandBuffer, &commandBufferBeginInfo);
+	if (res != VK_SUCCESS) return res;
+	vkCmdCopyBuffer(slot->downloadCommandBuffer, slot->outputBuffer, slot->downloadBuffer, 1, &copyRegion);
+	//make the download visible to the host after the fence
+	VkMemoryBarrier memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+	memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	vkCmdPipelineBarrier(slot->downloadCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, NULL, 0, NULL);
+	res = vkEndCommandBuffer(slot->downloadCommandBuffer);
+	if (res != VK_SUCCESS) return res;
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &slot->uploadCommandBuffer;
+	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.pSignalSemaphores = &slot->uploaded;
+	res = vkQueueSubmit(vkGPU->transferQueue, 1, &submitInfo, VK_NULL_HANDLE);
+	if (res != VK_SUCCESS) return res;
+	VkPipelineStageFlags computeWaitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	submitInfo.waitSemaphoreCount = 1;
+	submitInfo.pWaitSemaphores = &slot->uploaded;
+	submitInfo.pWaitDstStageMask = &computeWaitStage;
+	submitInfo.pCommandBuffers = &slot->computeCommandBuffer;
+	submitInfo.pSignalSemaphores = &slot->transposed;
+	res = vkQueueSubmit(vkGPU->queue, 1, &submitInfo, VK_NULL_HANDLE);
+	if (res != VK_SUCCESS) return res;
+	VkPipelineStageFlags downloadWaitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	submitInfo.pWaitSemaphores = &slot->transposed;
+	submitInfo.pWaitDstStageMask = &downloadWaitStage;
+	submitInfo.pCommandBuffers = &slot->downloadCommandBuffer;
+	submitInfo.signalSemaphoreCount = 0;
+	submitInfo.pSignalSemaphores = NULL;
+	res = vkQueueSubmit(vkGPU->transferQueue, 1, &submitInfo, slot->fence);
+	return res;
+}
+VkResult streamApp(VkGPU* vkGPU, VkApplication* app, void* input, void* output, uint32_t panelRows, uint32_t numSlots) {
+	//out-of-core transposition: the host input is split in panels of panelRows rows, each of them is uploaded, transposed and downloaded as a column panel of the host output.
+	//numSlots sets of buffers are in flight: the transfer queue uploads the next panel and downloads the previous one while the compute queue transposes the current one, and the host copies panels in and out of the staging buffers meanwhile
+	VkResult res = VK_SUCCESS;
+	if (app->dataType >= VK_APP_NUM_DATA_TYPES) return VK_ERROR_INITIALIZATION_FAILED;
+	uint64_t elementSize = dataTypes[app->dataType].size;
+	if (numSlots == 0) numSlots = 3;
+	if (panelRows == 0) {
+		//about 32 MB per panel
+		uint64_t rows = ((uint64_t)32 * 1024 * 1024) / (elementSize * app->size[0]);
+		panelRows = (rows > 0) ? (uint32_t)rows : 1;
+	}
+	if (panelRows > app->size[1]) panelRows = app->size[1];
+	VkDeviceSize panelSize = elementSize * app->size[0] * panelRows;
+	uint32_t numPanels = (app->size[1] + panelRows - 1) / panelRows;
+	VkAppStreamSlot* slots = (VkAppStreamSlot*)calloc(numSlots, sizeof(VkAppStreamSlot));
+	if (slots == NULL) return VK_ERROR_OUT_OF_HOST_MEMORY;
+	//one dynamic-shape plan serves the full panels and the last one. Each slot binds its own buffers, the descriptor set ring holds a set for every slot in flight
+	VkApplication plan = { 0 };
+	for (uint32_t i = 0; i < numSlots; i++) {
+		VkAppStreamSlot* slot = &slots[i];
+		slot->panel = -1;
+		res = allocateFFTBuffer(vkGPU, &slot->uploadBuffer, &slot->uploadBufferDeviceMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, panelSize);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = vkMapMemory(vkGPU->device, slot->uploadBufferDeviceMemory, 0, panelSize, 0, &slot->uploadData);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = allocateFFTBuffer(vkGPU, &slot->downloadBuffer, &slot->downloadBufferDeviceMemory, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, panelSize);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = vkMapMemory(vkGPU->device, slot->downloadBufferDeviceMemory, 0, panelSize, 0, &slot->downloadData);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = allocateFFTBuffer(vkGPU, &slot->inputBuffer, &slot->inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, panelSize);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = allocateFFTBuffer(vkGPU, &slot->outputBuffer, &slot->outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, panelSize);
+		if (res != VK_SUCCESS) goto cleanup;
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+		commandBufferAllocateInfo.commandPool = vkGPU->transferCommandPool;
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+		res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &slot->uploadCommandBuffer);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &slot->downloadCommandBuffer);
+		if (res != VK_SUCCESS) goto cleanup;
+		commandBufferAllocateInfo.commandPool = vkGPU->commandPool;
+		res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &slot->computeCommandBuffer);
+		if (res != VK_SUCCESS) goto cleanup;
+		VkSemaphoreCreateInfo semaphoreCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+		res = vkCreateSemaphore(vkGPU->device, &semaphoreCreateInfo, NULL, &slot->uploaded);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = vkCreateSemaphore(vkGPU->device, &semaphoreCreateInfo, NULL, &slot->transposed);
+		if (res != VK_SUCCESS) goto cleanup;
+		VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+		res = vkCreateFence(vkGPU->device, &fenceCreateInfo, NULL, &slot->fence);
+		if (res != VK_SUCCESS) goto cleanup;
+	}
+	plan.size[0] = app->size[0];
+	plan.size[1] = panelRows;
+	plan.size[2] = 1;
+	plan.dataType = app->dataType;
+	plan.coalescedMemory = app->coalescedMemory;
+	plan.tileDim = app->tileDim;
+	plan.blockRows = app->blockRows;
+	plan.vectorWidth = app->vectorWidth;
+	plan.tileOrder = app->tileOrder;
+	plan.dynamicShape = 1;
+	plan.descriptorSetCount = numSlots + 1;
+	plan.inputBufferSize = panelSize;
+	plan.inputBuffer = &slots[0].inputBuffer;
+	plan.outputBufferSize = panelSize;
+	plan.outputBuffer = &slots[0].outputBuffer;
+	res = createApp(vkGPU, &plan, 0);
+	if (res != VK_SUCCESS) goto cleanup;
+	for (uint32_t k = 0; k < numPanels + numSlots; k++) {
+		VkAppStreamSlot* slot = &slots[k % numSlots];
+		//collect the panel that was submitted numSlots panels ago
+		if (slot->panel >= 0) {
+			res = vkWaitForFences(vkGPU->device, 1, &slot->fence, VK_TRUE, 100000000000);
+			if (res != VK_SUCCESS) goto cleanup;
+			res = vkResetFences(vkGPU->device, 1, &slot->fence);
+			if (res != VK_SUCCESS) goto cleanup;
+			scatterPanel(app, slot, panelRows, output);
+			slot->panel = -1;
+		}
+		if (k >= numPanels) continue;
+		slot->panelRows = (k < numPanels - 1) ? panelRows : app->size[1] - k * panelRows;
+		VkDeviceSize copySize = elementSize * app->size[0] * slot->panelRows;
+		memcpy(slot->uploadData, (char*)input + (uint64_t)k * panelSize, copySize);
+		plan.size[1] = slot->panelRows;
+		res = reshapeApp(vkGPU, &plan);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = bindApp(vkGPU, &plan, &slot->inputBuffer, panelSize, &slot->outputBuffer, panelSize);
+		if (res != VK_SUCCESS) goto cleanup;
+		res = submitStreamPanel(vkGPU, &plan, slot, copySize);
+		if (res != VK_SUCCESS) goto cleanup;
+		slot->panel = k;
+	}
+cleanup:
+	//after an error some submits of the slots may still be pending, so both queues are drained before their resources are released
+	if (res != VK_SUCCESS) {
+		vkQueueWaitIdle(vkGPU->queue);
+		vkQueueWaitIdle(vkGPU->transferQueue);
+	}
+	deleteApp(vkGPU, &plan);
+	for (uint32_t i = 0; i < numSlots; i++) {
+		VkAppStreamSlot* slot = &slots[i];
+		if (slot->uploadCommandBuffer != VK_NULL_HANDLE) vkFreeCommandBuffers(vkGPU->device, vkGPU->transferCommandPool, 1, &slot->uploadCommandBuffer);
+		if (slot->downloadCommandBuffer != VK_NULL_HANDLE) vkFreeCommandBuffers(vkGPU->device, vkGPU->transferCommandPool, 1, &slot->downloadCommandBuffer);
+		if (slot->computeCommandBuffer != VK_NULL_HANDLE) vkFreeCommandBuffers(vkGPU->device, vkGPU->commandPool, 1, &slot->computeCommandBuffer);
+		vkDestroySemaphore(vkGPU->device, slot->uploaded, NULL);
+		vkDestroySemaphore(vkGPU->device, slot->transposed, NULL);
+		vkDestroyFence(vkGPU->device, slot->fence, NULL);
+		if (slot->uploadData != NULL) vkUnmapMemory(vkGPU->device, slot->uploadBufferDeviceMemory);
+		if (slot->downloadData != NULL) vkUnmapMemory(vkGPU->device, slot->downloadBufferDeviceMemory);
+		freeFFTBuffer(vkGPU, &slot->uploadBuffer, &slot->uploadBufferDeviceMemory);
+		freeFFTBuffer(vkGPU, &slot->downloadBuffer, &slot->downloadBufferDeviceMemory);
+		freeFFTBuffer(vkGPU, &slot->inputBuffer, &slot->inputBufferDeviceMemory);
+		freeFFTBuffer(vkGPU, &slot->outputBuffer, &slot->outputBufferDeviceMemory);
+	}
+	free(slots);
+	return res;
+}
+typedef struct {
+	VkAppMultiPlan* multiPlan;
+	void* input;
+	void* output;
+	double* bandTimes;
+	VkResult* results;
+} VkAppMultiGPU;
+void deleteBand(VkGPU* vkGPU, VkAppBand* band) {
+	//release the plan, command buffer and buffers of a band, handles that were not created are VK_NULL_HANDLE
+	deleteApp(vkGPU, &band->plan);
+	if (band->commandBuffer != VK_NULL_HANDLE) vkFreeCommandBuffers(vkGPU->device, vkGPU->commandPool, 1, &band->commandBuffer);
+	if (band->uploadData != NULL) vkUnmapMemory(vkGPU->device, band->uploadBufferDeviceMemory);
+	if (band->downloadData != NULL) vkUnmapMemory(vkGPU->device, band->downloadBufferDeviceMemory);
+	freeFFTBuffer(vkGPU, &band->uploadBuffer, &band->uploadBufferDeviceMemory);
+	freeFFTBuffer(vkGPU, &band->downloadBuffer, &band->downloadBufferDeviceMemory);
+	freeFFTBuffer(vkGPU, &band->inputBuffer, &band->inputBufferDeviceMemory);
+	freeFFTBuffer(vkGPU, &band->outputBuffer, &band->outputBufferDeviceMemory);
+	memset(band, 0, sizeof(VkAppBand));
+}
+VkResult createBand(VkGPU* vkGPU, VkApplication* app, VkAppBand* band) {
+	//staging buffers stay mapped, and the upload, the transposition and the download of the band are recorded once in one command buffer
+	VkResult res = VK_SUCCESS;
+	uint64_t elementSize = dataTypes[app->dataType].size;
+	VkDeviceSize bandSize = elementSize * band->bandWidth * app->size[1];
+	res = allocateFFTBuffer(vkGPU, &band->uploadBuffer, &band->uploadBufferDeviceMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, bandSize);
+	if (res != VK_SUCCESS) return res;
+	res = vkMapMemory(vkGPU->device, band->uploadBufferDeviceMemory, 0, bandSize, 0, &band->uploadData);
+	if (res != VK_SUCCESS) return res;
+	res = allocateFFTBuffer(vkGPU, &band->downloadBuffer, &band->downloadBufferDeviceMemory, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, bandSize);
+	if (res != VK_SUCCESS) return res;
+	res = vkMapMemory(vkGPU->device, band->downloadBufferDeviceMemory, 0, bandSize, 0, &band->downloadData);
+	if (res != VK_SUCCESS) return res;
+	res = allocateFFTBuffer(vkGPU, &band->inputBuffer, &band->inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bandSize);
+	if (res != VK_SUCCESS) return res;
+	res = allocateFFTBuffer(vkGPU, &band->outputBuffer, &band->outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bandSize);
+	if (res != VK_SUCCESS) return res;
+	VkApplication* plan = &band->plan;
+	plan->size[0] = band->bandWidth;
+	plan->size[1] = app->size[1];
+	plan->size[2] = 1;
+	plan->dataType = app->dataType;
+	plan->coalescedMemory = app->coalescedMemory;
+	plan->tileDim = app->tileDim;
+	plan->blockRows = app->blockRows;
+	plan->vectorWidth = app->vectorWidth;
+	plan->tileOrder = app->tileOrder;
+	plan->inputBufferSize = bandSize;
+	plan->inputBuffer = &band->inputBuffer;
+	plan->outputBufferSize = bandSize;
+	plan->outputBuffer = &band->outputBuffer;
+	res = createApp(vkGPU, plan, 0);
+	if (res != VK_SUCCESS) return res;
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = vkGPU->commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &band->commandBuffer);
+	if (res != VK_SUCCESS) return res;
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	res = vkBeginCommandBuffer(band->commandBuffer, &commandBufferBeginInfo);
+	if (res != VK_SUCCESS) return res;
+	VkBufferCopy copyRegion = { 0 };
+	copyRegion.size = bandSize;
+	vkCmdCopyBuffer(band->commandBuffer, band->uploadBuffer, band->inputBuffer, 1, &copyRegion);
+	VkMemoryBarrier memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+	memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(band->commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, NULL, 0, NULL);
+	appendApp(vkGPU, plan, &band->commandBuffer);
+	memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+	vkCmdPipelineBarrier(band->commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, NULL, 0, NULL);
+	vkCmdCopyBuffer(band->commandBuffer, band->outputBuffer, band->downloadBuffer, 1, &copyRegion);
+	memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	vkCmdPipelineBarrier(band->commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, NULL, 0, NULL);
+	res = vkEndCommandBuffer(band->commandBuffer);
+	return res;
+}
+VkResult transposeBand(VkGPU* vkGPU, VkApplication* app, VkAppBand* band, void* input, void* output) {
+	//the band of input columns is gathered row by row directly into the mapped upload buffer, and its transposition is a contiguous band of output rows, copied out of the mapped download buffer
+	VkResult res = VK_SUCCESS;
+	uint64_t elementSize = dataTypes[app->dataType].size;
+	VkDeviceSize bandSize = elementSize * band->bandWidth * app->size[1];
+	for (uint64_t i = 0; i < app->size[1]; i++) {
+		memcpy((char*)band->uploadData + i * band->bandWidth * elementSize, (char*)input + (i * app->size[0] + band->bandStart) * elementSize, band->bandWidth * elementSize);
+	}
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &band->commandBuffer;
+	res = vkQueueSubmit(vkGPU->queue, 1, &submitInfo, vkGPU->fence);
+	if (res != VK_SUCCESS) return res;
+	res = vkWaitForFences(vkGPU->device, 1, &vkGPU->fence, VK_TRUE, 100000000000);
+	if (res != VK_SUCCESS) return res;
+	res = vkResetFences(vkGPU->device, 1, &vkGPU->fence);
+	if (res != VK_SUCCESS) return res;
+	memcpy((char*)output + (uint64_t)band->bandStart * app->size[1] * elementSize, band->downloadData, bandSize);
+	return res;
+}
+void createBandThread(void* data, uint32_t id) {
+	//set up the band of device id
+	VkAppMultiGPU* multiGPU = (VkAppMultiGPU*)data;
+	VkAppMultiPlan* multiPlan = multiGPU->multiPlan;
+	multiGPU->results[id] = VK_SUCCESS;
+	//devices without a band, if the matrix has fewer blocks than devices, have nothing to do
+	if (multiPlan->bands[id].bandWidth > 0)
+		multiGPU->results[id] = createBand(&multiPlan->vkGPUs[id], &multiPlan->app, &multiPlan->bands[id]);
+}
+void multiAppThread(void* data, uint32_t id) {
+	//transpose the band of device id, the time covers the gather, the submit and the scatter only
+	VkAppMultiGPU* multiGPU = (VkAppMultiGPU*)data;
+	VkAppMultiPlan* multiPlan = multiGPU->multiPlan;
+	double start = getWallTime();
+	multiGPU->results[id] = VK_SUCCESS;
+	if (multiPlan->bands[id].bandWidth > 0)
+		multiGPU->results[id] = transposeBand(&multiPlan->vkGPUs[id], &multiPlan->app, &multiPlan->bands[id], multiGPU->input, multiGPU->output);
+	if (multiGPU->bandTimes != NULL) multiGPU->bandTimes[id] = getWallTime() - start;
+}
+VkResult runMultiThreads(VkAppMultiPlan* multiPlan, void (*function)(void*, uint32_t), void* input, void* output, double* bandTimes) {
+	//run function for every device on its own thread and return the first error
+	VkResult res = VK_SUCCESS;
+	VkResult* results = (VkResult*)malloc(multiPlan->numGPUs * sizeof(VkResult));
+	if (results == NULL) return VK_ERROR_OUT_OF_HOST_MEMORY;
+	VkAppMultiGPU multiGPU = { 0 };
+	multiGPU.multiPlan = multiPlan;
+	multiGPU.input = input;
+	multiGPU.output = output;
+	multiGPU.bandTimes = bandTimes;
+	multiGPU.results = results;
+	res = runThreads(multiPlan->numGPUs, function, &multiGPU);
+	for (uint32_t i = 0; (i < multiPlan->numGPUs) && (res == VK_SUCCESS); i++)
+		res = results[i];
+	free(results);
+	return res;
+}
+VkResult createMultiApp(VkGPU* vkGPUs, uint32_t numGPUs, VkApplication* app, VkAppMultiPlan* multiPlan) {
+	//bands are split in whole multiples of VK_APP_MULTI_GPU_BAND_ALIGNMENT columns, the last band takes the remainder of the matrix. The devices have their own instances, so the bands are set up in parallel
+	VkResult res = VK_SUCCESS;
+	if ((app->dataType >= VK_APP_NUM_DATA_TYPES) || (numGPUs == 0)) return VK_ERROR_INITIALIZATION_FAILED;
+	memset(multiPlan, 0, sizeof(VkAppMultiPlan));
+	multiPlan->bands = (VkAppBand*)calloc(numGPUs, sizeof(VkAppBand));
+	if (multiPlan->bands == NULL) return VK_ERROR_OUT_OF_HOST_MEMORY;
+	multiPlan->vkGPUs = vkGPUs;
+	multiPlan->numGPUs = numGPUs;
+	multiPlan->app = app[0];
+	uint32_t numBlocks = (app->size[0] + VK_APP_MULTI_GPU_BAND_ALIGNMENT - 1) / VK_APP_MULTI_GPU_BAND_ALIGNMENT;
+	for (uint32_t i = 0; i < numGPUs; i++) {
+		uint32_t bandStart = (uint32_t)((uint64_t)numBlocks * i / numGPUs) * VK_APP_MULTI_GPU_BAND_ALIGNMENT;
+		uint32_t bandEnd = (uint32_t)((uint64_t)numBlocks * (i + 1) / numGPUs) * VK_APP_MULTI_GPU_BAND_ALIGNMENT;
+		if (bandEnd > app->size[0]) bandEnd = app->size[0];
+		multiPlan->bands[i].bandStart = bandStart;
+		multiPlan->bands[i].bandWidth = (bandEnd > bandStart) ? bandEnd - bandStart : 0;
+	}
+	res = runMultiThreads(multiPlan, createBandThread, NULL, NULL, NULL);
+	if (res != VK_SUCCESS) deleteMultiApp(multiPlan);
+	return res;
+}
+VkResult multiApp(VkAppMultiPlan* multiPlan, void* input, void* output, double* bandTimes) {
+	//every device has its own instance, queue and staging, so the bands only share the host matrices and run on their own threads without locks
+	return runMultiThreads(multiPlan, multiAppThread, input, output, bandTimes);
+}
+void deleteMultiApp(VkAppMultiPlan* multiPlan) {
+	//release the bands of all devices, the devices themselves stay
+	if (multiPlan->bands != NULL) {
+		for (uint32_t i = 0; i < multiPlan->numGPUs; i++)
+			deleteBand(&multiPlan->vkGPUs[i], &multiPlan->bands[i]);
+	}
+	free(multiPlan->bands);
+	memset(multiPlan, 0, sizeof(VkAppMultiPlan));
+}
+//8x8 register-tile kernels of the CPU transposition. SIMD kernels are compiled for their instruction set with target attributes and selected at run time, so the library does not need -march flags.
+//Compilers without target attributes (MSVC) use the instruction sets enabled for the whole build
+#if defined(VK_APP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define VK_APP_TARGET(isa) __attribute__((target(isa)))
+#define VK_APP_HAS_SSE2() __builtin_cpu_supports("sse2")
+#define VK_APP_HAS_AVX2() __builtin_cpu_supports("avx2")
+#define VK_APP_HAS_AVX512() __builtin_cpu_supports("avx512f")
+#elif defined(VK_APP_X86)
+#define VK_APP_TARGET(isa)
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define VK_APP_HAS_SSE2() 1
+#else
+#define VK_APP_HAS_SSE2() 0
+#endif
+#ifdef __AVX2__
+#define VK_APP_HAS_AVX2() 1
+#else
+#define VK_APP_HAS_AVX2() 0
+#endif
+#ifdef __AVX512F__
+#define VK_APP_HAS_AVX512() 1
+#else
+#define VK_APP_HAS_AVX512() 0
+#endif
+#endif
+#define VK_APP_CPU_BLOCK_DIM 64
+typedef void (*VkAppCPUTileKernel)(const char* input, char* output, uint64_t inputPitch, uint64_t outputPitch);
+typedef struct {
+	uint64_t x[2];
+} VkAppElement128;
+//scalar tiles for every element size, row pitches are in bytes
+#define VK_APP_SCALAR_TILE(name, type) \
+void name(const char* input, char* output, uint64_t inputPitch, uint64_t outputPitch) { \
+	for (uint32_t i = 0; i < 8; i++) { \
+		for (uint32_t j = 0; j < 8; j++) \
+			((type*)(output + j * outputPitch))[i] = ((const type*)(input + i * inputPitch))[j]; \
+	} \
+}
+VK_APP_SCALAR_TILE(transposeTileScalar8, uint8_t)
+VK_APP_SCALAR_TILE(transposeTileScalar16, uint16_t)
+VK_APP_SCALAR_TILE(transposeTileScalar32, uint32_t)
+VK_APP_SCALAR_TILE(transposeTileScalar64, uint64_t)
+VK_APP_SCALAR_TILE(transposeTileScalar128, VkAppElement128)
+#ifdef VK_APP_X86
+VK_APP_TARGET("sse2") void transposeTileSSE8(const char* input, char* output, uint64_t inputPitch, uint64_t outputPitch) {
+	//each row is 8 bytes in the lower half of a register, interleaving bytes, words and dwords leaves two output rows in each register
+	__m128i b0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(input)), _mm_loadl_epi64((const __m128i*)(input + inputPitch)));
+	__m128i b1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(input + 2 * inputPitch)), _mm_loadl_epi64((const __m128i*)(input + 3 * inputPitch)));
+	__m128i b2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(input + 4 * inputPitch)), _mm_loadl_epi64((const __m128i*)(input + 5 * inputPitch)));
+	__m128i b3 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(input + 6 * inputPitch)), _mm_loadl_epi64((const __m128i*)(input + 7 * inputPitch)));
+	__m128i c0 = _mm_unpacklo_epi16(b0, b1);
+	__m128i c1 = _mm_unpackhi_epi16(b0, b1);
+	__m128i c2 = _mm_unpacklo_epi16(b2, b3);
+	__m128i c3 = _mm_unpackhi_epi16(b2, b3);
+	__m128i d[4];
+	d[0] = _mm_unpacklo_epi32(c0, c2);
+	d[1] = _mm_unpackhi_epi32(c0, c2);
+	d[2] = _mm_unpacklo_epi32(c1, c3);
+	d[3] = _mm_unpackhi_epi32(c1, c3);
+	for (uint32_t i = 0; i < 4; i++) {
+		_mm_storel_epi64((__m128i*)(output + 2 * i * outputPitch), d[i]);
+		_mm_storel_epi64((__m128i*)(output + (2 * i + 1) * outputPitch), _mm_srli_si128(d[i], 8));
+	}
+}
+VK_APP_TARGET("sse2") void transposeTileSSE16(const char* input, char* output, uint64_t inputPitch, uint64_t outputPitch) {
+	//8 rows of 8 words, interleaved by words, dwords and qwords
+	__m128i a[8];
+	for (uint32_t i = 0; i < 8; i++)
+		a[i] = _mm_loadu_si128((const __m128i*)(input + i * inputPitch));
+	__m128i b0 = _mm_unpacklo_epi16(a[0], a[1]);
+	__m128i b1 = _mm_unpackhi_epi16(a[0], a[1]);
+	__m128i b2 = _mm_unpacklo_epi16(a[2], a[3]);
+	__m128i b3 = _mm_unpackhi_epi16(a[2], a[3]);
+	__m128i b4 = _mm_unpacklo_epi16(a[4], a[5]);
+	__m128i b5 = _mm_unpackhi_epi16(a[4], a[5]);
+	__m128i b6 = _mm_unpacklo_epi16(a[6], a[7]);
+	__m128i b7 = _mm_unpackhi_epi16(a[6], a[7]);
+	__m128i c0 = _mm_unpacklo_epi32(b0, b2);
+	__m128i c1 = _mm_unpackhi_epi32(b0, b2);
+	__m128i c2 = _mm_unpacklo_epi32(b1, b3);
+	__m128i c3 = _mm_unpackhi_epi32(b1, b3);
+	__m128i c4 = _mm_unpacklo_epi32(b4, b6);
+	__m128i c5 = _mm_unpackhi_epi32(b4, b6);
+	__m128i c6 = _mm_unpacklo_epi32(b5, b7);
+	__m128i c7 = _mm_unpackhi_epi32(b5, b7);
+	_mm_storeu_si128((__m128i*)(output), _mm_unpacklo_epi64(c0, c4));
+	_mm_storeu_si128((__m128i*)(output + outputPitch), _mm_unpackhi_epi64(c0, c4));
+	_mm_storeu_si128((__m128i*)(output + 2 * outputPitch), _mm_unpacklo_epi64(c1, c5));
+	_mm_storeu_si128((__m128i*)(output + 3 * outputPitch), _mm_unpackhi_epi64(c1, c5));
+	_mm_storeu_si128((__m128i*)(output + 4 * outputPitch), _mm_unpacklo_epi64(c2, c6));
+	_mm_storeu_si128((__m128i*)(output + 5 * outputPitch), _mm_unpackhi_epi64(c2, c6));
+	_mm_storeu_si128((__m128i*)(output + 6 * outputPitch), _mm_unpacklo_epi64(c3, c7));
+	_mm_storeu_si128((__m128i*)(output + 7 * outputPitch), _mm_unpackhi_epi64(c3, c7));
+}
+VK_APP_TARGET("sse2") void transposeTileSSE32(const char* input, char* output, uint64_t inputPitch, uint64_t outputPitch) {
+	//four 4x4 subtiles, subtile (i, j) of the input is subtile (j, i) of the output
+	for (uint32_t i = 0; i < 8; i += 4) {
+		for (uint32_t j = 0; j < 8; j += 4) {
+			__m128 r0 = _mm_loadu_ps((const float*)(input + i * inputPitch) + j);
+			__m128 r1 = _mm_loadu_ps((const float*)(input + (i + 1) * inputPitch) + j);
+			__m128 r2 = _mm_loadu_ps((const float*)(input + (i + 2) * inputPitch) + j);
+			__m128 r3 = _mm_loadu_ps((const float*)(input + (i + 3) * inputPitch) + j);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			_mm_storeu_ps((float*)(output + j * outputPitch) + i, r0);
+			_mm_storeu_ps((float*)(output + (j + 1) * outputPitch) + i, r1);
+			_mm_storeu_ps((float*)(output + (j + 2) * outputPitch) + i, r2);
+			_mm_storeu_ps((float*)(output + (j + 3) * outputPitch) + i, r3);
+		}
+	}
+}
+VK_APP_TARGET("avx2") void transposeTileAVX2_32(const char* input, char* output, uint64_t inputPitch, uint64_t outputPitch) {
+	//one row per register: interleave pairs of rows, combine 64-bit pairs, then swap 128-bit lanes
+	__m256 r[8];
+	for (uint32_t i = 0; i < 8; i++)
+		r[i] = _mm256_loadu_ps((const float*)(input + i * inputPitch));
+	__m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+	__m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+	__m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+	__m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+	__m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+	__m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+	__m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+	__m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+	__m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+	_mm256_storeu_ps((float*)(output), _mm256_permute2f128_ps(s0, s4, 0x20));
+	_mm256_storeu_ps((float*)(output + outputPitch), _mm256_permute2f128_ps(s1, s5, 0x20));
+	_mm256_storeu_ps((float*)(output + 2 * outputPitch), _mm256_permute2f128_ps(s2, s6, 0x20));
+	_mm256_storeu_ps((float*)(output + 3 * outputPitch), _mm256_permute2f128_ps(s3, s7, 0x20));
+	_mm256_storeu_ps((float*)(output + 4 * outputPitch), _mm256_permute2f128_ps(s0, s4, 0x31));
+	_mm256_storeu_ps((float*)(output + 5 * outputPitch), _mm256_permute2f128_ps(s1, s5, 0x31));
+	_mm256_storeu_ps((float*)(output + 6 * outputPitch), _mm256_permute2f128_ps(s2, s6, 0x31));
+	_mm256_storeu_ps((float*)(output + 7 * outputPitch), _mm256_permute2f128_ps(s3, s7, 0x31));
+}
+VK_APP_TARGET("avx2") void transposeTileAVX2_64(const char* input, char* output, uint64_t inputPitch, uint64_t outputPitch) {
+	//four 4x4 subtiles of 64-bit elements, a row of a subtile per register
+	for (uint32_t i = 0; i < 8; i += 4) {
+		for (uint32_t j = 0; j < 8; j += 4) {
+			__m256d r0 = _mm256_loadu_pd((const double*)(input + i * inputPitch) + j);
+			__m256d r1 = _mm256_loadu_pd((const double*)(input + (i + 1) * inputPitch) + j);
+			__m256d r2 = _mm256_loadu_pd((const double*)(input + (i + 2) * inputPitch) + j);
+			__m256d r3 = _mm256_loadu_pd((const double*)(input + (i + 3) * inputPitch) + j);
+			__m256d t0 = _mm256_unpacklo_pd(r0, r1);
+			__m256d t1 = _mm256_unpackhi_pd(r0, r1);
+			__m256d t2 = _mm256_unpacklo_pd(r2, r3);
+			__m256d t3 = _mm256_unpackhi_pd(r2, r3);
+			_mm256_storeu_pd((double*)(output + j * outputPitch) + i, _mm256_permute2f128_pd(t0, t2, 0x20));
+			_mm256_storeu_pd((double*)(output + (j + 1) * outputPitch) + i, _mm256_permute2f128_pd(t1, t3, 0x20));
+			_mm256_storeu_pd((double*)(output + (j + 2) * outputPitch) + i, _mm256_permute2f128_pd(t0, t2, 0x31));
+			_mm256_storeu_pd((double*)(output + (j + 3) * outputPitch) + i, _mm256_permute2f128_pd(t1, t3, 0x31));
+		}
+	}
+}
+VK_APP_TARGET("avx512f") void transposeTileAVX512_64(const char* input, char* output, uint64_t inputPitch, uint64_t outputPitch) {
+	//one row of 8 64-bit elements per register: interleave pairs of rows, then gather 128-bit lanes twice
+	__m512i r[8];
+	for (uint32_t i = 0; i < 8; i++)
+		r[i] = _mm512_loadu_si512((const void*)(input + i * inputPitch));
+	__m512i t0 = _mm512_unpacklo_epi64(r[0], r[1]);
+	__m512i t1 = _mm512_unpackhi_epi64(r[0], r[1]);
+	__m512i t2 = _mm512_unpacklo_epi64(r[2], r[3]);
+	__m512i t3 = _mm512_unpackhi_epi64(r[2], r[3]);
+	__m512i t4 = _mm512_unpacklo_epi64(r[4], r[5]);
+	__m512i t5 = _mm512_unpackhi_epi64(r[4], r[5]);
+	__m512i t6 = _mm512_unpacklo_epi64(r[6], r[7]);
+	__m512i t7 = _mm512_unpackhi_epi64(r[6], r[7]);
+	__m512i u0 = _mm512_shuffle_i64x2(t0, t2, 0x88);
+	__m512i u1 = _mm512_shuffle_i64x2(t0, t2, 0xDD);
+	__m512i u2 = _mm512_shuffle_i64x2(t1, t3, 0x88);
+	__m512i u3 = _mm512_shuffle_i64x2(t1, t3, 0xDD);
+	__m512i u4 = _mm512_shuffle_i64x2(t4, t6, 0x88);
+	__m512i u5 = _mm512_shuffle_i64x2(t4, t6, 0xDD);
+	__m512i u6 = _mm512_shuffle_i64x2(t5, t7, 0x88);
+	__m512i u7 = _mm512_shuffle_i64x2(t5, t7, 0xDD);
+	_mm512_storeu_si512((void*)(output), _mm512_shuffle_i64x2(u0, u4, 0x88));
+	_mm512_storeu_si512((void*)(output + outputPitch), _mm512_shuffle_i64x2(u2, u6, 0x88));
+	_mm512_storeu_si512((void*)(output + 2 * outputPitch), _mm512_shuffle_i64x2(u1, u5, 0x88));
+	_mm512_storeu_si512((void*)(output + 3 * outputPitch), _mm512_shuffle_i64x2(u3, u7, 0x88));
+	_mm512_storeu_si512((void*)(output + 4 * outputPitch), _mm512_shuffle_i64x2(u0, u4, 0xDD));
+	_mm512_storeu_si512((void*)(output + 5 * outputPitch), _mm512_shuffle_i64x2(u2, u6, 0xDD));
+	_mm512_storeu_si512((void*)(output + 6 * outputPitch), _mm512_shuffle_i64x2(u1, u5, 0xDD));
+	_mm512_storeu_si512((void*)(output + 7 * outputPitch), _mm512_shuffle_i64x2(u3, u7, 0xDD));
+}
+#endif
+VkAppCPUTileKernel getCPUTileKernel(uint32_t elementSize, const char** kernelName) {
+	//widest kernel supported by the host for the element size
+	kernelName[0] = "scalar";
+#ifdef VK_APP_X86
+	if ((elementSize == 8) && VK_APP_HAS_AVX512()) {
+		kernelName[0] = "AVX-512";
+		return transposeTileAVX512_64;
+	}
+	if ((elementSize == 8) && VK_APP_HAS_AVX2()) {
+		kernelName[0] = "AVX2";
+		return transposeTileAVX2_64;
+	}
+	if ((elementSize == 4) && VK_APP_HAS_AVX2()) {
+		kernelName[0] = "AVX2";
+		return transposeTileAVX2_32;
+	}
+	if (((elementSize == 1) || (elementSize == 2) || (elementSize == 4)) && VK_APP_HAS_SSE2()) {
+		kernelName[0] = "SSE2";
+		return (elementSize == 1) ? transposeTileSSE8 : ((elementSize == 2) ? transposeTileSSE16 : transposeTileSSE32);
+	}
+#endif
+	switch (elementSize) {
+	case 1:
+		return transposeTileScalar8;
+	case 2:
+		return transposeTileScalar16;
+	case 4:
+		return transposeTileScalar32;
+	case 8:
+		return transposeTileScalar64;
+	default:
+		return transposeTileScalar128;
+	}
+}
+const char* getCPUKernelName(uint32_t dataType) {
+	const char* kernelName = NULL;
+	if (dataType >= VK_APP_NUM_DATA_TYPES) return NULL;
+	getCPUTileKernel(dataTypes[dataType].size, &kernelName);
+	return kernelName;
+}
+typedef struct {
+	VkApplication* app;
+	const char* input;
+	char* output;
+	uint32_t numThreads;
+	VkAppCPUTileKernel kernel;
+	//strides of the transposed layout, checked by cpuApp
+	uint32_t inputStride[3];
+	uint32_t outputStride[3];
+} VkAppCPUTransposition;
+void cpuAppThread(void* data, uint32_t id) {
+	//thread id takes every numThreads-th band of VK_APP_CPU_BLOCK_DIM input rows over all matrices. Bands are cut in blocks that fit in L1 with their transposition, blocks are cut in 8x8 tiles.
+	//tiles that cross the matrix edge are copied element by element
+	VkAppCPUTransposition* transposition = (VkAppCPUTransposition*)data;
+	VkApplication* app = transposition->app;
+	uint64_t elementSize = dataTypes[app->dataType].size;
+	uint32_t* inputStride = transposition->inputStride;
+	uint32_t* outputStride = transposition->outputStride;
+	uint64_t inputPitch = inputStride[1] * elementSize;
+	uint64_t outputPitch = outputStride[1] * elementSize;
+	uint32_t bandsPerMatrix = (app->size[1] + VK_APP_CPU_BLOCK_DIM - 1) / VK_APP_CPU_BLOCK_DIM;
+	for (uint64_t band = id; band < (uint64_t)bandsPerMatrix * app->size[2]; band += transposition->numThreads) {
+		uint64_t matrix = band / bandsPerMatrix;
+		uint32_t rowStart = (uint32_t)(band % bandsPerMatrix) * VK_APP_CPU_BLOCK_DIM;
+		uint32_t rowEnd = (rowStart + VK_APP_CPU_BLOCK_DIM < app->size[1]) ? rowStart + VK_APP_CPU_BLOCK_DIM : app->size[1];
+		const char* input = transposition->input + matrix * inputStride[2] * elementSize;
+		char* output = transposition->output + matrix * outputStride[2] * elementSize;
+		for (uint32_t columnStart = 0; columnStart < app->size[0]; columnStart += VK_APP_CPU_BLOCK_DIM) {
+			uint32_t columnEnd = (columnStart + VK_APP_CPU_BLOCK_DIM < app->size[0]) ? columnStart + VK_APP_CPU_BLOCK_DIM : app->size[0];
+			for (uint32_t i = rowStart; i < rowEnd; i += 8) {
+				for (uint32_t j = columnStart; j < columnEnd; j += 8) {
+					if ((i + 8 <= rowEnd) && (j + 8 <= columnEnd)) {
+						transposition->kernel(input + i * inputPitch + j * elementSize, output + j * outputPitch + i * elementSize, inputPitch, outputPitch);
+						continue;
+					}
+					for (uint32_t k = i; k < rowEnd && k < i + 8; k++) {
+						for (uint32_t l = j; l < columnEnd && l < j + 8; l++)
+							memcpy(output + l * outputPitch + k * elementSize, input + k * inputPitch + l * elementSize, elementSize);
+					}
+				}
+			}
+		}
+	}
+}
+VkResult cpuApp(VkApplication* app, void* input, void* output, uint32_t numThreads) {
+	//host transposition with the layout of the plan, used when no device is available and as the baseline of the GPU kernels
+	if (app->dataType >= VK_APP_NUM_DATA_TYPES) return VK_ERROR_INITIALIZATION_FAILED;
+	//the output is always transposed, whatever shaderID the plan was created with. Row and matrix strides that are too small would write outside of the host arrays
+	VkApplication layout = app[0];
+	layout.shaderID = 0;
+	VkResult res = checkAppStrides(&layout);
+	if (res != VK_SUCCESS) return res;
+	VkAppCPUTransposition transposition = { 0 };
+	const char* kernelName = NULL;
+	getAppStrides(&layout, transposition.inputStride, transposition.outputStride);
+	transposition.app = app;
+	transposition.input = (const char*)input;
+	transposition.output = (char*)output;
+	transposition.numThreads = (numThreads) ? numThreads : getCoreCount();
+	transposition.kernel = getCPUTileKernel(dataTypes[app->dataType].size, &kernelName);
+	return runThreads(transposition.numThreads, cpuAppThread, &transposition);
+}
+
+VkResult devices_list() {
+	//this function creates an instance and prints the list of available devices
+	VkResult res = VK_SUCCESS;
+	VkInstance local_instance = {0};
+	VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+	createInfo.flags = 0;
+	createInfo.pApplicationInfo = NULL;
+	VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo = { VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT };
+	createInfo.enabledLayerCount = 0;
+	createInfo.enabledExtensionCount = 0;
+	createInfo.pNext = NULL;
+	res = vkCreateInstance(&createInfo, NULL, &local_instance);
+	if (res != VK_SUCCESS) return res;
+
+	uint32_t deviceCount;
+	res = vkEnumeratePhysicalDevices(local_instance, &deviceCount, NULL);
+	if (res != VK_SUCCESS) return res;
+
+	VkPhysicalDevice* devices=(VkPhysicalDevice *) malloc(sizeof(VkPhysicalDevice)*deviceCount);
+	res = vkEnumeratePhysicalDevices(local_instance, &deviceCount, devices);
+	if (res != VK_SUCCESS) return res;
+	for (uint32_t i = 0; i < deviceCount; i++) {
+		VkPhysicalDeviceProperties device_properties;
+		vkGetPhysicalDeviceProperties(devices[i], &device_properties);
+		printf("Device id: %d name: %s API:%d.%d.%d\n", i, device_properties.deviceName, (device_properties.apiVersion >> 22), ((device_properties.apiVersion >> 12) & 0x3ff), (device_properties.apiVersion & 0xfff));
+	}
+	free(devices);
+	vkDestroyInstance(local_instance, NULL);
+	return res;
+}
+
+VkResult createGPU(VkGPU* vkGPU) {
+	//create all Vulkan primitives required to run applications on the GPU with id vkGPU->device_id
+	VkResult res = VK_SUCCESS;
+	//create instance - a connection between the application and the Vulkan library 
+	res = createInstance(vkGPU);
+	if (res != VK_SUCCESS) {
+		printf("Instance creation failed, error code: %d\n", res);
+		return res;
+	}
+	//set up the debugging messenger 
+	res = setupDebugMessenger(vkGPU);
+	if (res != VK_SUCCESS) {
+		printf("Debug messenger creation failed, error code: %d\n", res);
+		return res;
+	}
+	//check if there are GPUs that support Vulkan and select one
+	res = findPhysicalDevice(vkGPU);
+	if (res != VK_SUCCESS) {
+		printf("Physical device not found, error code: %d\n", res);
+		return res;
+	}
+	//get device properties and memory properties, device creation depends on the supported API version
+	vkGetPhysicalDeviceProperties(vkGPU->physicalDevice, &vkGPU->physicalDeviceProperties);
+	vkGetPhysicalDeviceMemoryProperties(vkGPU->physicalDevice, &vkGPU->physicalDeviceMemoryProperties);
+	if (vkGPU->physicalDeviceProperties.apiVersion < VK_API_VERSION_1_1) vkGPU->apiVersion = VK_API_VERSION_1_0;
+	//create logical device representation
+	res = createDevice(vkGPU);
+	if (res != VK_SUCCESS) {
+		printf("Device creation failed, error code: %d\n", res);
+		return res;
+	}
+	//create fence for synchronization 
+	res = createFence(vkGPU);
+	if (res != VK_SUCCESS) {
+		printf("Fence creation failed, error code: %d\n", res);
+		return res;
+	}
+	//create a place, command buffer memory is allocated from
+	res = createCommandPool(vkGPU);
+	if (res != VK_SUCCESS) {
+		printf("Command pool creation failed, error code: %d\n", res);
+		return res;
+	}
+	//create the pipeline cache, loaded from the pipeline cache file if it matches the device and driver
+	res = createPipelineCache(vkGPU);
+	if (res != VK_SUCCESS) {
+		printf("Pipeline cache creation failed, error code: %d\n", res);
+		return res;
+	}
+	//create the persistent staging ring used by the transfers between the CPU and the GPU
+	res = createStagingRing(vkGPU);
+	if (res != VK_SUCCESS) {
+		printf("Staging buffer creation failed, error code: %d\n", res);
+		return res;
+	}
+	return res;
+}
+void deleteGPU(VkGPU* vkGPU) {
+	//destroy Vulkan primitives created by createGPU. The pipeline cache is saved first, so the next process starts with compiled pipelines
+	if (savePipelineCache(vkGPU) != VK_SUCCESS) printf("Could not write pipeline cache: %s\n", vkGPU->pipelineCachePath);
+	vkDestroyPipelineCache(vkGPU->device, vkGPU->pipelineCache, NULL);
+	//transfers in flight are finished first, pending downloads are delivered
+	while (vkGPU->retiredTransferID + 1 < vkGPU->nextTransferID) {
+		if (retireTransfer(vkGPU) != VK_SUCCESS) break;
+	}
+	for (uint32_t i = 0; i < VK_APP_MAX_TRANSFERS; i++) {
+		vkFreeCommandBuffers(vkGPU->device, vkGPU->transferCommandPool, 1, &vkGPU->transfers[i].commandBuffer);
+		vkDestroyFence(vkGPU->device, vkGPU->transfers[i].fence, NULL);
+	}
+	if (vkGPU->stagingData != NULL) vkUnmapMemory(vkGPU->device, vkGPU->stagingBufferDeviceMemory);
+	freeFFTBuffer(vkGPU, &vkGPU->stagingBuffer, &vkGPU->stagingBufferDeviceMemory);
+	//buffers that were not freed by their users are released with their blocks
+	for (uint32_t i = 0; i < vkGPU->numBufferAllocations; i++) {
+		vkDestroyBuffer(vkGPU->device, vkGPU->bufferAllocations[i].buffer, NULL);
+		vkFreeMemory(vkGPU->device, vkGPU->bufferAllocations[i].memory, NULL);
+	}
+	for (uint32_t i = 0; i < vkGPU->numMemoryBlocks; i++) {
+		vkFreeMemory(vkGPU->device, vkGPU->memoryBlocks[i].memory, NULL);
+		free(vkGPU->memoryBlocks[i].slotUsed);
+	}
+	free(vkGPU->bufferAllocations);
+	free(vkGPU->memoryBlocks);
+	vkDestroyFence(vkGPU->device, vkGPU->fence, NULL);
+	vkDestroyCommandPool(vkGPU->device, vkGPU->transferCommandPool, NULL);
+	vkDestroyCommandPool(vkGPU->device, vkGPU->commandPool, NULL);
+	vkDestroyDevice(vkGPU->device, NULL);
+	DestroyDebugUtilsMessengerEXT(vkGPU, NULL);
+	vkDestroyInstance(vkGPU->instance, NULL);
+}
+uint32_t defaultCoalescedMemory(VkGPU* vkGPU) {
+	//how much memory is coalesced per transfer on a given vendor, used if coalescedMemory is not specified
+	switch (vkGPU->physicalDeviceProperties.vendorID) {
+	case 0x10DE://NVIDIA - change to 128 before Pascal
+		return 32;
+	case 0x8086://INTEL
+		return 64;
+	case 0x1002://AMD
+		return 64;
+	case 0x13B5://ARM
+		return 64;
+	default:
+		return 64;
+	}
+}
+uint32_t parseTuningRecord(char* line, VkAppTuningRecord* record) {
+	//parse one line of the tuning database, returns 1 on success. Lines starting with # are comments
+	char dataTypeName[64];
+	if (line[0] == '#') return 0;
+	if (sscanf(line, "%x %x %x %63s %u %u %u %u %u %u %lf", &record->vendorID, &record->deviceID, &record->driverVersion, dataTypeName, &record->size[0], &record->size[1], &record->shaderID, &record->tileDim, &record->blockRows, &record->vectorWidth, &record->time) != 11) return 0;
+	for (uint32_t i = 0; i < VK_APP_NUM_DATA_TYPES; i++) {
+		if (strcmp(dataTypeName, dataTypes[i].name) == 0) {
+			record->dataType = i;
+			return 1;
+		}
+	}
+	return 0;
+}
+uint32_t findTuningRecord(VkGPU* vkGPU, const char* tuningPath, uint32_t dataType, uint32_t sizeX, uint32_t sizeY, VkAppTuningRecord* record) {
+	//search the tuning database for the configuration of the device with the same vendorID, deviceID and driverVersion. An exact shape match is preferred, otherwise the last record of the same data type is used. Returns 1 if a record is found
+	FILE* fp = fopen(tuningPath, "r");
+	if (fp == NULL) return 0;
+	uint32_t found = 0;
+	char line[512];
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		VkAppTuningRecord entry = { 0 };
+		if (parseTuningRecord(line, &entry) == 0) continue;
+		if ((entry.vendorID != vkGPU->physicalDeviceProperties.vendorID) || (entry.deviceID != vkGPU->physicalDeviceProperties.deviceID) || (entry.driverVersion != vkGPU->physicalDeviceProperties.driverVersion) || (entry.dataType != dataType)) continue;
+		uint32_t exactShape = (entry.size[0] == sizeX) && (entry.size[1] == sizeY);
+		if ((found == 2) && (!exactShape)) continue;
+		record[0] = entry;
+		found = (exactShape) ? 2 : 1;
+	}
+	fclose(fp);
+	return (found > 0);
+}
+VkResult saveTuningRecord(const char* tuningPath, VkAppTuningRecord* record) {
+	//add the record to the tuning database, replacing the record with the same device, data type and shape. The database is written under a temporary name and renamed,
+	//so a crash or another autotuning run never leaves it truncated
+	VkResult res = VK_SUCCESS;
+	char** lines = NULL;
+	uint32_t numLines = 0;
+	char line[512];
+	FILE* fp = fopen(tuningPath, "r");
+	if (fp != NULL) {
+		while (fgets(line, sizeof(line), fp) != NULL) {
+			VkAppTuningRecord entry = { 0 };
+			if (parseTuningRecord(line, &entry) == 0) continue;
+			if ((entry.vendorID == record->vendorID) && (entry.deviceID == record->deviceID) && (entry.driverVersion == record->driverVersion) && (entry.dataType == record->dataType) && (entry.size[0] == record->size[0]) && (entry.size[1] == record->size[1])) continue;
+			char** newLines = (char**)realloc(lines, sizeof(char*) * (numLines + 1));
+			if (newLines == NULL) {
+				res = VK_ERROR_OUT_OF_HOST_MEMORY;
+				break;
+			}
+			lines = newLines;
+			lines[numLines] = (char*)malloc(strlen(line) + 1);
+			if (lines[numLines] == NULL) {
+				res = VK_ERROR_OUT_OF_HOST_MEMORY;
+				break;
+			}
+			strcpy(lines[numLines], line);
+			numLines++;
+		}
+		fclose(fp);
+	}
+	//the temporary name has the process id, so concurrent autotuning runs never write the same temporary file
+	char temporaryPath[1024];
+#ifdef _WIN32
+	unsigned long processID = (unsigned long)GetCurrentProcessId();
+#else
+	unsigned long processID = (unsigned long)getpid();
+#endif
+	int pathLength = snprintf(temporaryPath, sizeof(temporaryPath), "%s.%lu.%llx.tmp", tuningPath, processID, (unsigned long long)(uintptr_t)record);
+	if ((res == VK_SUCCESS) && ((pathLength < 0) || (pathLength >= (int)sizeof(temporaryPath)))) res = VK_ERROR_INITIALIZATION_FAILED;
+	fp = (res == VK_SUCCESS) ? fopen(temporaryPath, "w") : NULL;
+	if ((res == VK_SUCCESS) && (fp == NULL)) res = VK_ERROR_INITIALIZATION_FAILED;
+	if (fp != NULL) {
+		uint32_t written = (fprintf(fp, "#vendorID deviceID driverVersion dataType sizeX sizeY shaderID tileDim blockRows vectorWidth time(ms)\n") >= 0);
+		for (uint32_t i = 0; i < numLines; i++) {
+			if (fputs(lines[i], fp) < 0) written = 0;
+		}
+		if (fprintf(fp, "%x %x %x %s %u %u %u %u %u %u %.6f\n", record->vendorID, record->deviceID, record->driverVersion, dataTypes[record->dataType].name, record->size[0], record->size[1], record->shaderID, record->tileDim, record->blockRows, record->vectorWidth, record->time) < 0) written = 0;
+		if (fclose(fp) != 0) written = 0;
+		if (!written) {
+			remove(temporaryPath);
+			res = VK_ERROR_INITIALIZATION_FAILED;
+		}
+		else {
+#ifdef _WIN32
+			//rename does not replace existing files on Windows
+			remove(tuningPath);
+#endif
+			if (rename(temporaryPath, tuningPath) != 0) {
+				remove(temporaryPath);
+				res = VK_ERROR_INITIALIZATION_FAILED;
+			}
+		}
+	}
+	for (uint32_t i = 0; i < numLines; i++) free(lines[i]);
+	free(lines);
+	return res;
+}
+#ifdef __cplusplus
+}
+#endif
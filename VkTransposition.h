@@ -0,0 +1,459 @@
+#ifndef VK_TRANSPOSITION_H
+#define VK_TRANSPOSITION_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <memory.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h> 
+#include "vulkan/vulkan.h"
+
+//Vulkan Compute transposition library. Usage:
+//1. createGPU creates the instance, the device, the pipeline cache and all other Vulkan primitives of the GPU with id device_id. One VkGPU is shared by all plans created on it.
+//2. a plan is a VkApplication: fill size, dataType, strides and the input and output buffers (allocated by the caller, allocateFFTBuffer can be used), then call createApp with the selected shader.
+//3. executeApp runs the plan on the queue of the GPU and waits for it, appendApp records it into the caller's command buffer instead.
+//4. deleteApp destroys the plan, deleteGPU destroys the device after all plans are destroyed.
+
+//maximum number of axes in the tensor permutation
+#define VK_APP_MAX_AXES 6
+//number of asynchronous transfers in flight, the oldest one is waited for when a new one does not fit
+#define VK_APP_MAX_TRANSFERS 16
+//maximum number of compute queues created on a device, and number of jobs in flight on each queue of the scheduler
+#define VK_APP_MAX_QUEUES 16
+#define VK_APP_MAX_QUEUE_JOBS 8
+//order in which the workgroups of the 2D transposition visit the tiles: row by row, along the diagonals of the tile grid, or in bands of 8 tile rows filled column by column
+#define VK_APP_TILE_ORDER_LINEAR 0
+#define VK_APP_TILE_ORDER_DIAGONAL 1
+#define VK_APP_TILE_ORDER_SWIZZLED 2
+
+//device memory is allocated in blocks of VK_APP_MEMORY_BLOCK_SIZE bytes, split in slots of one size class (powers of two, starting from VK_APP_MIN_SIZE_CLASS).
+//buffers larger than a quarter of the block and host-visible buffers, which are mapped by their users, get their own allocation
+#define VK_APP_MEMORY_BLOCK_SIZE (64 * 1024 * 1024)
+#define VK_APP_MIN_SIZE_CLASS 4096
+
+typedef struct {
+	VkDeviceMemory memory;
+	uint32_t memoryTypeIndex;
+	VkDeviceSize slotSize;//size class of the block
+	uint32_t numSlots;
+	uint32_t usedSlots;
+	uint8_t* slotUsed;
+} VkAppMemoryBlock;
+typedef struct {
+	VkBuffer buffer;
+	VkDeviceMemory memory;//dedicated memory of the buffer, VK_NULL_HANDLE if it is sub-allocated from a block
+	uint32_t block;
+	uint32_t slot;
+} VkAppBufferAllocation;
+typedef struct {
+	uint64_t id;//transfer id returned by uploadDataAsync or downloadDataAsync, 0 - free
+	VkCommandBuffer commandBuffer;
+	VkFence fence;
+	VkDeviceSize stagingOffset;//region of the staging ring used by the transfer
+	VkDeviceSize size;
+	void* hostData;//destination of a download, it is written when the transfer is waited for. NULL for uploads
+} VkAppTransfer;
+typedef struct {
+	VkInstance instance;//a connection between the application and the Vulkan library 
+	VkPhysicalDevice physicalDevice;//a handle for the graphics card used in the application
+	VkPhysicalDeviceProperties physicalDeviceProperties;//bastic device properties
+	VkPhysicalDeviceMemoryProperties physicalDeviceMemoryProperties;//bastic memory properties of the device
+	uint32_t apiVersion;//Vulkan version used with the device, the lower of the loader and device versions: 1.1 or 1.0. 8/16-bit storage, host memory import and subgroup shuffles need 1.1
+	PFN_vkGetPhysicalDeviceFeatures2 getPhysicalDeviceFeatures2;//1.1 entry points, loaded from the instance if apiVersion is 1.1
+	PFN_vkGetPhysicalDeviceProperties2 getPhysicalDeviceProperties2;
+	VkDevice device;//a logical device, interacting with physical device
+	VkDebugUtilsMessengerEXT debugMessenger;//extension for debugging
+	uint32_t queueFamilyIndex;//if multiple queues are available, specify the used one
+	uint32_t timestampValidBits;//number of meaningful bits in timestamps written by the selected queue family, 0 if timestamps are not supported
+	VkBool32 storage8Bit;//whether 8-bit elements can be stored in storage buffers
+	VkBool32 storage16Bit;//whether 16-bit elements can be stored in storage buffers
+	VkBool32 externalMemoryHost;//whether VK_EXT_external_memory_host is enabled, so host allocations can be imported as buffers
+	VkDeviceSize minImportedHostPointerAlignment;//imported host allocations have to be aligned and padded to this size
+	PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties;
+	VkQueue queue;//a place, where all operations are submitted
+	VkCommandPool commandPool;//an opaque objects that command buffer memory is allocated from
+	uint32_t transferQueueFamilyIndex;//queue family used by the transfers between the CPU and the GPU: a dedicated transfer-only family if the device has one, queueFamilyIndex otherwise
+	VkQueue transferQueue;
+	VkCommandPool transferCommandPool;
+	//every queue of every compute-capable family is created, computeQueues[0] is queue. Buffers are shared by all queueFamilies of the device
+	uint32_t numComputeQueues;
+	VkQueue computeQueues[VK_APP_MAX_QUEUES];
+	uint32_t computeQueueFamilies[VK_APP_MAX_QUEUES];
+	uint32_t numQueueFamilies;
+	uint32_t queueFamilies[VK_APP_MAX_QUEUES + 1];
+	VkDeviceSize stagingBufferSize;//size of the persistent staging ring, 0 - default 64 MB
+	VkBuffer stagingBuffer;//host-visible staging ring, mapped for the lifetime of the GPU
+	VkDeviceMemory stagingBufferDeviceMemory;
+	void* stagingData;
+	VkDeviceSize stagingHead;//the next transfer is placed at this offset of the staging ring, if it fits
+	VkAppTransfer transfers[VK_APP_MAX_TRANSFERS];//transfer with id n uses transfers[n % VK_APP_MAX_TRANSFERS]
+	uint64_t nextTransferID;
+	uint64_t retiredTransferID;//transfers with this and smaller ids are finished
+	VkFence fence;//a fence used to synchronize dispatches
+	VkPipelineCache pipelineCache;//cache of compiled pipelines, shared by all applications of the device
+	const char* pipelineCachePath;//file the pipeline cache is loaded from and saved to, NULL - cache is kept in memory only
+	const char* tuningPath;//tuning database used by createApp for 2D transposition plans without a tile configuration, NULL - defaults are used
+	size_t pipelineCacheLoadedSize;//size of the pipeline cache data loaded from the file, 0 if the cache started cold
+	//device memory sub-allocator: blocks, live buffers and statistics. Empty blocks are kept until deleteGPU, so they are reused by the next buffers
+	VkAppMemoryBlock* memoryBlocks;
+	uint32_t numMemoryBlocks;
+	VkAppBufferAllocation* bufferAllocations;
+	uint32_t numBufferAllocations;
+	uint32_t maxBufferAllocations;
+	uint32_t dedicatedMemory;//1 - every buffer gets its own vkAllocateMemory, as without the sub-allocator
+	uint64_t memoryAllocationCount;//number of vkAllocateMemory calls
+	uint64_t bufferAllocationCount;//number of allocateFFTBuffer calls
+	double memoryAllocationTime;//time spent in allocateFFTBuffer (in ms)
+	const char* shaderDir;//directory with the compiled shaders, NULL - SHADER_DIR set at build time
+	uint32_t device_id;//an id of a device, reported by Vulkan device list
+} VkGPU;//an example structure containing Vulkan primitives
+typedef struct {
+	uint32_t localSize[3];
+	uint32_t inputStride[3];
+	uint32_t outputStride[3];
+	uint32_t size[3];
+	//tensor permutation: extents and strides of the two tiled axes and of up to four remaining axes, number of remaining index combinations and whether the tile is transposed
+	uint32_t tileExtent[2];
+	uint32_t tileInputStride[2];
+	uint32_t tileOutputStride[2];
+	uint32_t batchExtent[4];
+	uint32_t batchInputStride[4];
+	uint32_t batchOutputStride[4];
+	uint32_t batchCount;
+	uint32_t transposeTile;
+	//rectangular in-place transposition: n / gcd(m, n), m / gcd(m, n) and the number of rows or columns permuted by one pass
+	uint32_t rotationDivisor;
+	uint32_t shuffleDivisor;
+	uint32_t scratchLines;
+	//2D transposition and transfer: number of consecutive elements moved by a thread as one vector and whether sizes and strides are read from push constants
+	uint32_t vectorWidth;
+	uint32_t dynamicShape;
+	//bandwidth probes: probe type and stride in words
+	uint32_t probe;
+	uint32_t probeStride;
+	//2D transposition: workgroup to tile mapping
+	uint32_t tileOrder;
+	//subgroup shuffle transposition: tile edge, equal to the subgroup size
+	uint32_t subgroupTile;
+} VkAppSpecializationConstantsLayout;//an example structure on how to set constants in the shader after first compilation but before final shader module creation
+
+typedef struct {
+	uint32_t pushID;//an example structure on how to pass small amount of data to the shader right before dispatch
+	uint32_t lineOffset;//first row or column processed by a pass of the rectangular in-place transposition
+	//shape of the 2D transposition and transfer, if the pipeline was created with dynamicShape
+	uint32_t size[3];
+	uint32_t inputStride[3];
+	uint32_t outputStride[3];
+} VkAppPushConstantsLayout;
+typedef struct {
+	//per-dispatch GPU execution time statistics (in ms), measured with timestamp queries around each appendApp call
+	double min;
+	double median;
+	double p95;
+	double max;
+	double mean;
+	//host time (in ms) spent in the vkQueueSubmit call
+	double hostSubmit;
+	//host time (in ms) from vkQueueSubmit to the fence signal for the whole batch
+	double hostTotal;
+	//part of hostTotal (in ms) that is not covered by GPU execution of the batch: submit latency and fence wait overhead
+	double hostOverhead;
+	//1 if statistics are taken from GPU timestamps, 0 if the queue has no timestamp support and host timer was used instead
+	uint32_t gpuTimestamps;
+} VkAppTimings;//timing results of runApp
+typedef struct {
+	const char* name;//name used in the CLI and in the results
+	const char* shaderSuffix;//suffix of the shader binaries compiled for this element size, see CMakeLists.txt
+	uint32_t size;//element size in bytes
+} VkAppDataType;//element type of the transposed data. Elements are moved bit-exact, so the shaders only depend on the element size
+//supported element types: fp32, fp16, fp64, int8, complex_fp32, complex_fp64
+#define VK_APP_NUM_DATA_TYPES 6
+extern const VkAppDataType dataTypes[VK_APP_NUM_DATA_TYPES];
+typedef struct {
+	//device the configuration was tuned on. Driver updates change the compiled shaders, so they invalidate the record
+	uint32_t vendorID;
+	uint32_t deviceID;
+	uint32_t driverVersion;
+	//tuned problem: data type (index in dataTypes) and matrix size
+	uint32_t dataType;
+	uint32_t size[2];
+	//fastest configuration: shaderID 0 - padded shared memory, 1 - unpadded shared memory, the tile configuration of VkApplication and its median dispatch time in ms
+	uint32_t shaderID;
+	uint32_t tileDim;
+	uint32_t blockRows;
+	uint32_t vectorWidth;
+	double time;
+} VkAppTuningRecord;//one record of the tuning database, stored as a line of text
+typedef struct {
+	//system size for transposition: number of columns (contiguous dimension), number of rows and number of matrices in a batch. Any sizes are supported, edge tiles are bounds-checked
+	uint32_t size[3];
+	//how much memory is coalesced (in bytes) - 32 for Nvidia, 64 for Intel, 64 for AMD. Maximum value: 128
+	uint32_t coalescedMemory;
+	//element type, index in dataTypes (default 0 - fp32)
+	uint32_t dataType;
+	//strides (in elements) between the rows and between the matrices of the input and of the output, 0 - packed, so sub-matrices of larger arrays can be transposed. Used by shaderID 0-2, 7 and 4 (input strides only), other shaders need packed data.
+	//a row stride has to cover its row and a matrix stride all rows of the matrix. The output of the transfer shader (shaderID 2) has the shape of the input, the output of the transposition is transposed
+	uint32_t inputRowStride;
+	uint32_t inputMatrixStride;
+	uint32_t outputRowStride;
+	uint32_t outputMatrixStride;
+	//tensor permutation (shaderID 3): number of axes and their extents, axes[0] is contiguous. Output axis i is the input axis permutation[i], in the same innermost-first order
+	uint32_t numAxes;
+	uint32_t axes[VK_APP_MAX_AXES];
+	uint32_t permutation[VK_APP_MAX_AXES];
+	//rectangular in-place transposition (shaderID 5): number of rows or columns permuted at once (default 64). outputBuffer is the scratch buffer of scratchLines * max(size[0], size[1]) elements
+	uint32_t scratchLines;
+	//2D transposition and transfer tiles (shaderID 0-2, 0 - default): tile edge in elements, number of thread rows in the workgroup and number of consecutive elements moved by a thread as one vector (1, 2 or 4). The workgroup is tileDim / vectorWidth x blockRows threads, each of them moves tileDim / blockRows rows of the tile. createApp replaces them with the values used
+	//the subgroup shuffle transposition (shaderID 7) transposes tiles of subgroup size x subgroup size elements in registers, one tile per subgroup. createApp sets tileDim to the subgroup size, the other tile parameters are not used
+	uint32_t tileDim;
+	uint32_t blockRows;
+	uint32_t vectorWidth;
+	//set by createApp if the tile configuration was loaded from the tuning database of the GPU. A plan created with shaderID 0 then uses the faster of the padded and unpadded shaders, shaderID holds the one used
+	uint32_t tuned;
+	//2D transposition (shaderID 0-1): VK_APP_TILE_ORDER_* mapping of the workgroups to the tiles (0 - row by row). The other orders spread the writes of concurrent workgroups over more memory channels
+	uint32_t tileOrder;
+	//bandwidth probes (shaderID 6): VK_APP_PROBE_* type and distance in words between the words accessed by consecutive threads of the strided probes (0 - 1). size[0] is the number of 32-bit words moved,
+	//a multiple of 4 and of probeStride, the data type only selects the shader binary. VK_APP_PROBE_COPY_BUFFER records vkCmdCopyBuffer, so the buffers also need transfer usage
+	uint32_t probe;
+	uint32_t probeStride;
+	//2D shaders (shaderID 0-2): 1 - sizes and strides are passed as push constants, so one pipeline serves every shape with the same tile configuration. The shape is changed with reshapeApp
+	uint32_t dynamicShape;
+	//shader used by the application and the number of workgroups launched by appendApp
+	uint32_t shaderID;
+	uint32_t dispatchSize[3];
+	VkAppSpecializationConstantsLayout specializationConstants;
+	VkAppPushConstantsLayout pushConstants;
+	//bridging information, that allows shaders to freely access resources like buffers and images
+	VkDescriptorPool descriptorPool;
+	VkDescriptorSetLayout descriptorSetLayout;
+	//ring of descriptor sets (descriptorSetCount of them, 0 - default 8), each bindApp call writes the next one. descriptorSet is the set used by appendApp
+	uint32_t descriptorSetCount;
+	uint32_t descriptorSetIndex;
+	VkDescriptorSet* descriptorSets;
+	VkDescriptorSet descriptorSet;
+	//pipeline used for graphics applications, we only use compute part of it in this example
+	VkPipelineLayout pipelineLayout;
+	VkPipeline pipeline;
+	//command buffer with the dispatches of one application run, recorded once by recordApp and resubmitted by executeApp, and the fence it signals
+	VkCommandBuffer commandBuffer;
+	VkFence fence;
+	//descriptor set the command buffer was recorded with, executeApp records it again after bindApp or reshapeApp
+	VkDescriptorSet recordedDescriptorSet;
+	//input buffer
+	VkDeviceSize inputBufferSize;//the size of buffer (in bytes)
+	VkBuffer* inputBuffer;//pointer to the buffer object
+	VkDeviceMemory* inputBufferDeviceMemory;//pointer to the memory object, corresponding to the buffer
+	//output buffer
+	VkDeviceSize outputBufferSize;
+	VkBuffer* outputBuffer;
+	VkDeviceMemory* outputBufferDeviceMemory;
+} VkApplication;//application specific data
+typedef struct {
+	//plan cache key: element type, shader, requested coalescing and tile configuration (0 - default), shape and strides. Dynamic plans keep the shape zeroed, so one plan serves all shapes
+	uint32_t dataType;
+	uint32_t shaderID;
+	uint32_t coalescedMemory;
+	uint32_t tileDim;
+	uint32_t blockRows;
+	uint32_t vectorWidth;
+	uint32_t tileOrder;
+	uint32_t dynamicShape;
+	uint32_t size[3];
+	uint32_t strides[4];
+} VkAppPlanKey;
+typedef struct {
+	VkAppPlanKey key;
+	uint32_t calls;//number of calls with the key (shape counters)
+	uint64_t lastUse;//cache clock at the last call, the entry with the smallest value is replaced first
+	VkApplication app;//plans only
+} VkAppPlanCacheEntry;
+typedef struct {
+	uint32_t capacity;//maximum number of plans, 0 - default 16. The least recently used plan is destroyed when a new one does not fit
+	uint32_t specializeThreshold;//number of calls with one shape after which a plan specialized for it is compiled, 0 - default 8. Shapes with fewer calls run on the dynamic plan of their configuration
+	uint32_t numPlans;
+	VkAppPlanCacheEntry* plans;
+	uint32_t numShapes;
+	VkAppPlanCacheEntry* shapes;//call counters of the last 4 * capacity shapes
+	uint64_t clock;
+	//statistics: calls served by existing plans, created dynamic and specialized plans, destroyed plans and the time spent in createApp (in ms)
+	uint64_t hits;
+	uint64_t dynamicPlans;
+	uint64_t specializedPlans;
+	uint64_t evictions;
+	double createTime;
+} VkAppPlanCache;
+
+//shaders that can be selected by createApp: 0 - transposition with padded shared memory, 1 - transposition with unpadded shared memory (bank conflicts), 2 - copy without transposition,
+//3 - tensor permutation, 4 - in-place transposition of square matrices, 5 - in-place transposition of rectangular matrices with a scratch buffer in outputBuffer, 6 - bandwidth probes,
+//7 - transposition with subgroup shuffles (VK_ERROR_FEATURE_NOT_PRESENT without shuffle support, or if a tile column of the data type does not fit in the registers of a lane)
+
+//create all Vulkan primitives required to run applications on the GPU with id vkGPU->device_id
+VkResult createGPU(VkGPU* vkGPU);
+//destroy Vulkan primitives created by createGPU and save the pipeline cache
+void deleteGPU(VkGPU* vkGPU);
+//print the list of available devices
+VkResult devices_list();
+//how much memory is coalesced per transfer on a given vendor, used if coalescedMemory is not specified
+uint32_t defaultCoalescedMemory(VkGPU* vkGPU);
+
+//create a plan: compile the pipeline of the selected shader for the size, data type and strides of the application and bind its buffers
+VkResult createApp(VkGPU* vkGPU, VkApplication* app, uint32_t shaderID);
+//apply the size and strides of a plan created with dynamicShape. Only the push constants and the dispatch size change, the pipeline is reused
+VkResult reshapeApp(VkGPU* vkGPU, VkApplication* app);
+//bind another pair of input and output buffers to the plan without rebuilding its pipeline. The sets of the ring are reused after descriptorSetCount calls,
+//so command buffers that use a set must have finished execution by then
+VkResult bindApp(VkGPU* vkGPU, VkApplication* app, VkBuffer* inputBuffer, VkDeviceSize inputBufferSize, VkBuffer* outputBuffer, VkDeviceSize outputBufferSize);
+//record the plan into the caller's command buffer. The caller is responsible for the synchronization with the commands before and after it
+void appendApp(VkGPU* vkGPU, VkApplication* app, VkCommandBuffer* commandBuffer);
+//record the plan into its own command buffer, that is reused by executeApp
+VkResult recordApp(VkGPU* vkGPU, VkApplication* app);
+//run the plan once on the queue of the GPU and wait for it
+VkResult executeApp(VkGPU* vkGPU, VkApplication* app);
+//run the plan batch times in one submit and measure the execution time of each run. batch must be at least 1
+VkResult runApp(VkGPU* vkGPU, VkApplication* app, uint32_t batch, VkAppTimings* timings);
+//destroy the plan
+void deleteApp(VkGPU* vkGPU, VkApplication* app);
+#define VK_APP_PROBE_COPY 0
+#define VK_APP_PROBE_READ 1
+#define VK_APP_PROBE_WRITE 2
+#define VK_APP_PROBE_STRIDED_READ 3
+#define VK_APP_PROBE_STRIDED_WRITE 4
+#define VK_APP_PROBE_COPY_BUFFER 5
+#define VK_APP_NUM_PROBE_STRIDES 6
+typedef struct {
+	//bandwidth in GB/s of the probes: vec4 copy and vkCmdCopyBuffer (read + write), read-only reduction (read) and write-only fill (write)
+	double copy;
+	double copyBuffer;
+	double read;
+	double write;
+	//strided read and strided write (read + write) for strides of 1, 4, 16, 64, 256 and 1024 words
+	uint32_t strides[VK_APP_NUM_PROBE_STRIDES];
+	double stridedRead[VK_APP_NUM_PROBE_STRIDES];
+	double stridedWrite[VK_APP_NUM_PROBE_STRIDES];
+	//the faster of the two copies and the slowest strided probe, the efficiency bounds of the transposition kernels
+	double bestCopy;
+	double worstStrided;
+	uint32_t gpuTimestamps;
+} VkAppBandwidth;
+//run the bandwidth probes between two device buffers of at least size bytes, that have storage and transfer usage. Each probe runs batch times in one submit and the median time is used.
+//the probes move size bytes rounded down to a multiple of 16 KB, smaller sizes return VK_ERROR_INITIALIZATION_FAILED
+VkResult measureBandwidth(VkGPU* vkGPU, VkBuffer* inputBuffer, VkBuffer* outputBuffer, VkDeviceSize size, uint32_t batch, VkAppBandwidth* bandwidth);
+//buffer strides (in elements) of the input and the output of a 2D plan: the strides of the application, or packed ones where they are 0
+void getAppStrides(VkApplication* app, uint32_t* inputStride, uint32_t* outputStride);
+//check that the strides of a 2D plan do not make rows or matrices overlap, returns VK_ERROR_INITIALIZATION_FAILED if they do
+VkResult checkAppStrides(VkApplication* app);
+
+//get a plan of the 2D shaders (shaderID 0-2) for the size, data type, strides, tile configuration and buffers of request from the cache, creating it if needed.
+//the plan is owned by the cache and stays valid until the next getCachedApp call
+VkResult getCachedApp(VkGPU* vkGPU, VkAppPlanCache* cache, VkApplication* request, uint32_t shaderID, VkApplication** app);
+//destroy all plans of the cache
+void deletePlanCache(VkGPU* vkGPU, VkAppPlanCache* cache);
+
+typedef struct {
+	VkQueue queue;
+	uint32_t queueFamilyIndex;
+	VkCommandPool commandPool;
+	VkCommandBuffer commandBuffers[VK_APP_MAX_QUEUE_JOBS];
+	VkFence fences[VK_APP_MAX_QUEUE_JOBS];
+	uint64_t jobIDs[VK_APP_MAX_QUEUE_JOBS];//job in flight in each slot, 0 - free
+	uint32_t numJobs;//number of jobs in flight
+	uint64_t submittedJobs;
+} VkAppSchedulerQueue;
+typedef struct {
+	uint32_t numQueues;//number of used compute queues, 0 - all compute queues of the device
+	VkAppSchedulerQueue queues[VK_APP_MAX_QUEUES];
+	uint64_t nextJobID;
+	uint32_t lastQueue;//queue of the last job, ties between equally loaded queues are broken round-robin from it
+} VkAppScheduler;
+//scheduler of independent plans over the compute queues of the device. Each queue has its own command pool, command buffers and fences. submitApp records the plan with its current
+//descriptor set and submits it to the least loaded queue without waiting, the plan must not be bound to other buffers or deleted until its job is waited for
+VkResult createScheduler(VkGPU* vkGPU, VkAppScheduler* scheduler);
+VkResult submitApp(VkGPU* vkGPU, VkAppScheduler* scheduler, VkApplication* app, uint64_t* jobID);
+VkResult waitJob(VkGPU* vkGPU, VkAppScheduler* scheduler, uint64_t jobID);
+VkResult waitScheduler(VkGPU* vkGPU, VkAppScheduler* scheduler);
+void deleteScheduler(VkGPU* vkGPU, VkAppScheduler* scheduler);
+
+//find memory with specified properties, preferring memory types without other properties
+VkResult findMemoryType(VkGPU* vkGPU, uint32_t memoryTypeBits, VkMemoryPropertyFlags properties, uint32_t* memoryTypeIndex);
+//allocate the buffer used by the GPU with specified properties (VK_MEMORY_PROPERTY_* flags). deviceMemory may be shared with other buffers, the buffer is released with freeFFTBuffer
+VkResult allocateFFTBuffer(VkGPU* vkGPU, VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags, VkDeviceSize size);
+void freeFFTBuffer(VkGPU* vkGPU, VkBuffer* buffer, VkDeviceMemory* deviceMemory);
+//transfer data between the CPU and the GPU through the staging ring and wait for it
+VkResult transferDataFromCPU(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferSize);
+VkResult transferDataToCPU(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferSize);
+//asynchronous transfers of up to stagingBufferSize bytes at bufferOffset of the buffer on the transfer queue. The returned id is waited for with waitTransfer before the buffer is used by plans
+//or before arr of a download is read, arr of a download has to stay valid until then. Transfers finish in the order they are submitted
+VkResult uploadDataAsync(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferOffset, VkDeviceSize size, uint64_t* transferID);
+VkResult downloadDataAsync(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferOffset, VkDeviceSize size, uint64_t* transferID);
+VkResult waitTransfer(VkGPU* vkGPU, uint64_t transferID);
+//paths of hostApp. Imported - the plan reads and writes the host arrays directly, mapped - the host arrays are copied to and from host-visible device-local memory, staged - transfers through the staging ring
+#define VK_APP_HOST_PATH_STAGED 0
+#define VK_APP_HOST_PATH_IMPORTED 1
+#define VK_APP_HOST_PATH_MAPPED 2
+//import the host allocation as a buffer with VK_EXT_external_memory_host. hostPointer has to be aligned to minImportedHostPointerAlignment and the allocation padded to a multiple of it
+VkResult importHostBuffer(VkGPU* vkGPU, void* hostPointer, VkDeviceSize size, VkBuffer* buffer, VkDeviceMemory* deviceMemory);
+//transpose the host array input (app->inputBufferSize bytes) into the host array output (app->outputBufferSize bytes) with the created out-of-place plan app (shaders 0-2).
+//if allowZeroCopy is set, host arrays are imported if possible, or copied to host-visible device-local memory on integrated GPUs. Otherwise, or if both fail, the data goes through the staging ring.
+//the used path is returned in hostPath. The previous buffers of app are bound again afterwards
+VkResult hostApp(VkGPU* vkGPU, VkApplication* app, void* input, void* output, uint32_t allowZeroCopy, uint32_t* hostPath);
+//out-of-core transposition of the host matrix input (app->size[0] columns, app->size[1] rows) into the host matrix output (app->size[1] columns, app->size[0] rows), that do not have to fit in device memory.
+//app only provides the size, data type and tile configuration, it is not created. The input is split in panels of panelRows rows (0 - about 32 MB per panel), numSlots (0 - default 3) panels are in flight.
+//uploads and downloads run on the transfer queue and the transposition on the compute queue, chained by semaphores, so copies of one panel overlap the transposition of another
+VkResult streamApp(VkGPU* vkGPU, VkApplication* app, void* input, void* output, uint32_t panelRows, uint32_t numSlots);
+#define VK_APP_MULTI_GPU_BAND_ALIGNMENT 64
+typedef struct {
+	//band of input columns transposed by one device, with mapped staging buffers, device buffers, its plan and the command buffer that uploads, transposes and downloads it
+	uint32_t bandStart;
+	uint32_t bandWidth;//0 - the device has no band
+	VkBuffer uploadBuffer;
+	VkDeviceMemory uploadBufferDeviceMemory;
+	void* uploadData;
+	VkBuffer downloadBuffer;
+	VkDeviceMemory downloadBufferDeviceMemory;
+	void* downloadData;
+	VkBuffer inputBuffer;
+	VkDeviceMemory inputBufferDeviceMemory;
+	VkBuffer outputBuffer;
+	VkDeviceMemory outputBufferDeviceMemory;
+	VkApplication plan;
+	VkCommandBuffer commandBuffer;
+} VkAppBand;
+typedef struct {
+	VkGPU* vkGPUs;
+	uint32_t numGPUs;
+	VkApplication app;//size, data type and tile configuration of the whole matrix
+	VkAppBand* bands;//band of each device
+} VkAppMultiPlan;
+//split the transposition of a host matrix across numGPUs devices. Device i transposes a band of input columns, a multiple of VK_APP_MULTI_GPU_BAND_ALIGNMENT wide, that is a band of output rows.
+//app only provides the size, data type and tile configuration, it is not created. The plans, buffers and command buffers of all bands are created here, so multiApp only moves data
+VkResult createMultiApp(VkGPU* vkGPUs, uint32_t numGPUs, VkApplication* app, VkAppMultiPlan* multiPlan);
+//transposition of the host matrix input into the host matrix output with a plan of createMultiApp. Each device gathers, transposes and writes its band on its own host thread.
+//if bandTimes is not NULL, it receives the time of each device in ms
+VkResult multiApp(VkAppMultiPlan* multiPlan, void* input, void* output, double* bandTimes);
+//destroy the bands of a plan of createMultiApp
+void deleteMultiApp(VkAppMultiPlan* multiPlan);
+//transposition of the host array input into the host array output on the CPU, with the size, batch count, strides and data type of app, that does not have to be created. Serves hosts without a Vulkan device and as the baseline of the GPU kernels.
+//matrices are cut in cache blocks of 8x8 register tiles, transposed with the widest SIMD kernel supported by the host (SSE2, AVX2 or AVX-512), or a scalar one. numThreads host threads (0 - all cores) take interleaved bands of rows.
+//the output always has the transposed layout, app->shaderID is ignored. Strides that are too small for it return VK_ERROR_INITIALIZATION_FAILED
+VkResult cpuApp(VkApplication* app, void* input, void* output, uint32_t numThreads);
+//name of the tile kernel used by cpuApp for the data type on this host
+const char* getCPUKernelName(uint32_t dataType);
+
+//search the tuning database for the configuration of the device, returns 1 if a record is found
+uint32_t findTuningRecord(VkGPU* vkGPU, const char* tuningPath, uint32_t dataType, uint32_t sizeX, uint32_t sizeY, VkAppTuningRecord* record);
+//add the record to the tuning database, replacing the record with the same device, data type and shape
+VkResult saveTuningRecord(const char* tuningPath, VkAppTuningRecord* record);
+
+//wall clock time in ms
+double getWallTime();
+//number of logical processors of the host
+uint32_t getCoreCount();
+//run function(data, id) for id from 0 to numThreads - 1 on separate host threads and wait for all of them. id 0 runs on the calling thread
+VkResult runThreads(uint32_t numThreads, void (*function)(void*, uint32_t), void* data);
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -1,725 +1,156 @@
 ﻿#ifdef __cplusplus
 extern "C" {
 #endif
-#include <memory.h>
-#include <string.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <math.h>
-#include <time.h> 
-#include "vulkan/vulkan.h"
+#include "VkTransposition.h"
 
-#ifdef NDEBUG
-	const VkBool32 enableValidationLayers = 0;
-#else
-	const VkBool32 enableValidationLayers = 1;
-#endif
-typedef struct {
-	VkInstance instance;//a connection between the application and the Vulkan library 
-	VkPhysicalDevice physicalDevice;//a handle for the graphics card used in the application
-	VkPhysicalDeviceProperties physicalDeviceProperties;//bastic device properties
-	VkPhysicalDeviceMemoryProperties physicalDeviceMemoryProperties;//bastic memory properties of the device
-	VkDevice device;//a logical device, interacting with physical device
-	VkDebugUtilsMessengerEXT debugMessenger;//extension for debugging
-	uint32_t queueFamilyIndex;//if multiple queues are available, specify the used one
-	VkQueue queue;//a place, where all operations are submitted
-	VkCommandPool commandPool;//an opaque objects that command buffer memory is allocated from
-	VkFence fence;//a fence used to synchronize dispatches
-	uint32_t device_id;//an id of a device, reported by Vulkan device list
-} VkGPU;//an example structure containing Vulkan primitives
-typedef struct {
-	uint32_t localSize[3];
-	uint32_t inputStride[3];
-} VkAppSpecializationConstantsLayout;//an example structure on how to set constants in the shader after first compilation but before final shader module creation
-
-typedef struct {
-	uint32_t pushID;//an example structure on how to pass small amount of data to the shader right before dispatch
-} VkAppPushConstantsLayout;
-typedef struct {
-	//system size for transposition
-	uint32_t size[3];
-	//how much memory is coalesced (in bytes) - 32 for Nvidia, 64 for Intel, 64 for AMD. Maximum value: 128
-	uint32_t coalescedMemory;
-	VkAppSpecializationConstantsLayout specializationConstants;
-	VkAppPushConstantsLayout pushConstants;
-	//bridging information, that allows shaders to freely access resources like buffers and images
-	VkDescriptorPool descriptorPool;
-	VkDescriptorSetLayout descriptorSetLayout;
-	VkDescriptorSet descriptorSet;
-	//pipeline used for graphics applications, we only use compute part of it in this example
-	VkPipelineLayout pipelineLayout;
-	VkPipeline pipeline;
-	//input buffer
-	VkDeviceSize inputBufferSize;//the size of buffer (in bytes)
-	VkBuffer* inputBuffer;//pointer to the buffer object
-	VkDeviceMemory* inputBufferDeviceMemory;//pointer to the memory object, corresponding to the buffer
-	//output buffer
-	VkDeviceSize outputBufferSize;
-	VkBuffer* outputBuffer;
-	VkDeviceMemory* outputBufferDeviceMemory;
-} VkApplication;//application specific data
-
-
-uint32_t* VkFFTReadShader(uint32_t* length, const char* filename) {
-	//function that reads shader's SPIR - V bytecode
-	FILE* fp = fopen(filename, "rb");
-	if (fp == NULL) {
-		printf("Could not find or open file: %s\n", filename);
-	}
-
-	// get file size.
-	fseek(fp, 0, SEEK_END);
-	long filesize = ftell(fp);
-	fseek(fp, 0, SEEK_SET);
-
-	long filesizepadded = ((long)ceil(filesize / 4.0)) * 4;
-
-	char* str = (char*)malloc(sizeof(char) * filesizepadded);
-	fread(str, filesize, sizeof(char), fp);
-	fclose(fp);
-
-	for (long i = filesize; i < filesizepadded; i++) {
-		str[i] = 0;
-	}
-
-	length[0] = filesizepadded;
-	return (uint32_t*)str;
-}
-VkResult CreateDebugUtilsMessengerEXT(VkGPU* vkGPU, const VkDebugUtilsMessengerCreateInfoEXT* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkDebugUtilsMessengerEXT* pDebugMessenger) {
-	//pointer to the function, as it is not part of the core. Function creates debugging messenger
-	PFN_vkCreateDebugUtilsMessengerEXT func = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(vkGPU->instance, "vkCreateDebugUtilsMessengerEXT");
-	if (func != NULL) {
-		return func(vkGPU->instance, pCreateInfo, pAllocator, pDebugMessenger);
-	}
-	else {
-		return VK_ERROR_EXTENSION_NOT_PRESENT;
-	}
-}
-void DestroyDebugUtilsMessengerEXT(VkGPU* vkGPU, const VkAllocationCallbacks* pAllocator) {
-	//pointer to the function, as it is not part of the core. Function destroys debugging messenger
-	PFN_vkDestroyDebugUtilsMessengerEXT func = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(vkGPU->instance, "vkDestroyDebugUtilsMessengerEXT");
-	if (func != NULL) {
-		func(vkGPU->instance, vkGPU->debugMessenger, pAllocator);
-	}
-}
-static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, VkDebugUtilsMessageTypeFlagsEXT messageType, const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, void* pUserData) {
-	printf("validation layer: %s\n", pCallbackData->pMessage);
-	return VK_FALSE;
-}
-VkResult setupDebugMessenger(VkGPU* vkGPU) {
-	//function that sets up the debugging messenger 
-	if (enableValidationLayers == 0) return VK_SUCCESS;
-
-	VkDebugUtilsMessengerCreateInfoEXT createInfo = { VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT };
-	createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
-	createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
-	createInfo.pfnUserCallback = debugCallback;
-
-	if (CreateDebugUtilsMessengerEXT(vkGPU, &createInfo, NULL, &vkGPU->debugMessenger) != VK_SUCCESS) {
-		return VK_ERROR_INITIALIZATION_FAILED;
-	}
-	return VK_SUCCESS;
-}
-VkResult checkValidationLayerSupport() {
-	//check if validation layers are supported when an instance is created
-	uint32_t layerCount;
-	vkEnumerateInstanceLayerProperties(&layerCount, NULL);
-
-	VkLayerProperties* availableLayers = (VkLayerProperties*)malloc(sizeof(VkLayerProperties) * layerCount);
-	vkEnumerateInstanceLayerProperties(&layerCount, availableLayers);
-
-	for (uint32_t i = 0; i < layerCount; i++) {
-		if (strcmp("VK_LAYER_KHRONOS_validation", availableLayers[i].layerName) == 0) {
-			free(availableLayers);
-			return VK_SUCCESS;
-		}
-	}
-	free(availableLayers);
-	return VK_ERROR_LAYER_NOT_PRESENT;
-}
-VkResult createInstance(VkGPU* vkGPU) {
-	//create instance - a connection between the application and the Vulkan library 
-	VkResult res = VK_SUCCESS;
-	//check if validation layers are supported
-	if (enableValidationLayers == 1) {
-		res = checkValidationLayerSupport();
-		if (res != VK_SUCCESS) return res;
-	}
-	//sample app information
-	VkApplicationInfo applicationInfo = { VK_STRUCTURE_TYPE_APPLICATION_INFO };
-	applicationInfo.pApplicationName = "VulkanTest";
-	applicationInfo.applicationVersion = 1.0;
-	applicationInfo.pEngineName = "VulkanTest";
-	applicationInfo.engineVersion = 1.0;
-	applicationInfo.apiVersion = VK_API_VERSION_1_0;
-
-	VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
-	createInfo.flags = 0;
-	createInfo.pApplicationInfo = &applicationInfo;
-	//specify, whether debugging utils are required
-	if (enableValidationLayers == 1) {
-		const char* const extensions = { VK_EXT_DEBUG_UTILS_EXTENSION_NAME };
-		createInfo.enabledExtensionCount = 1;
-		createInfo.ppEnabledExtensionNames = &extensions;
-	}
-	else {
-		createInfo.enabledExtensionCount = 0;
-		createInfo.ppEnabledExtensionNames = NULL;
-	}
-	VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo = { VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT };
-	if (enableValidationLayers == 1) {
-		//query for the validation layer support in the instance
-		createInfo.enabledLayerCount = 1;
-		const char* validationLayers = "VK_LAYER_KHRONOS_validation";
-		createInfo.ppEnabledLayerNames = &validationLayers;
-		debugCreateInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
-		debugCreateInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
-		debugCreateInfo.pfnUserCallback = debugCallback;
-		createInfo.pNext = (VkDebugUtilsMessengerCreateInfoEXT*)&debugCreateInfo;
-	}
-	else {
-		createInfo.enabledLayerCount = 0;
-		createInfo.pNext = NULL;
-	}
-	//create instance
-	res = vkCreateInstance(&createInfo, NULL, &vkGPU->instance);
-	if (res != VK_SUCCESS) return res;
-	
-	return res;
+//names of the VK_APP_TILE_ORDER_* workgroup to tile mappings, as selected with -order
+const char* tileOrderNames[3] = { "linear", "diagonal", "swizzled" };
+void printTimings(const char* name, VkAppTimings* timings) {
+	//print per-dispatch statistics and the host submit latency of one runApp call
+	printf("%s: %.3f ms (min: %.3f ms, p95: %.3f ms, max: %.3f ms)\n", name, timings->median, timings->min, timings->p95, timings->max);
+	printf("	host submit: %.3f ms, submit to fence: %.3f ms, not covered by GPU execution: %.3f ms\n", timings->hostSubmit, timings->hostTotal, timings->hostOverhead);
 }
-VkResult findPhysicalDevice(VkGPU* vkGPU) {
-	//check if there are GPUs that support Vulkan and select one
-	VkResult res = VK_SUCCESS;
-	uint32_t deviceCount;
-	res = vkEnumeratePhysicalDevices(vkGPU->instance, &deviceCount, NULL);
-	if (res != VK_SUCCESS) return res;
-	if (deviceCount == 0) {
-		return VK_ERROR_DEVICE_LOST;
-	}
-
-	VkPhysicalDevice* devices = (VkPhysicalDevice*)malloc(sizeof(VkPhysicalDevice) * deviceCount);
-	res = vkEnumeratePhysicalDevices(vkGPU->instance, &deviceCount, devices);
-	if (res != VK_SUCCESS) return res;
-	vkGPU->physicalDevice = devices[vkGPU->device_id];
-	free(devices);
-	return VK_SUCCESS;
+uint16_t floatToHalf(float value) {
+	//convert float to half precision, rounding toward zero. Values out of the half range become infinity, subnormals are flushed to zero
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(float));
+	uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+	int32_t exponent = (int32_t)((bits >> 23) & 0xff) - 127 + 15;
+	uint16_t mantissa = (uint16_t)((bits >> 13) & 0x3ff);
+	if (exponent <= 0) return sign;
+	if (exponent >= 31) return sign | 0x7c00;
+	return sign | (uint16_t)(exponent << 10) | mantissa;
 }
-VkResult getComputeQueueFamilyIndex(VkGPU* vkGPU) {
-	//find a queue family for a selected GPU, select the first available for use
-	uint32_t queueFamilyCount;
-	vkGetPhysicalDeviceQueueFamilyProperties(vkGPU->physicalDevice, &queueFamilyCount, NULL);
-
-	VkQueueFamilyProperties* queueFamilies = (VkQueueFamilyProperties*)malloc(sizeof(VkQueueFamilyProperties) * queueFamilyCount);
-	vkGetPhysicalDeviceQueueFamilyProperties(vkGPU->physicalDevice, &queueFamilyCount, queueFamilies);
-	uint32_t i = 0;
-	for (; i < queueFamilyCount; i++) {
-		VkQueueFamilyProperties props = queueFamilies[i];
-
-		if (props.queueCount > 0 && (props.queueFlags & VK_QUEUE_COMPUTE_BIT)) {
+void fillInputData(void* buffer, uint32_t dataType, uint64_t numElements) {
+	//fill the buffer with the element index converted to the data type, complex numbers get -index as the imaginary part. Indices wrap around or lose precision in narrow types
+	for (uint64_t i = 0; i < numElements; i++) {
+		switch (dataType) {
+		case 0://fp32
+			((float*)buffer)[i] = (float)i;
+			break;
+		case 1://fp16
+			((uint16_t*)buffer)[i] = floatToHalf((float)i);
+			break;
+		case 2://fp64
+			((double*)buffer)[i] = (double)i;
+			break;
+		case 3://int8
+			((int8_t*)buffer)[i] = (int8_t)(i & 0xff);
+			break;
+		case 4://complex_fp32
+			((float*)buffer)[2 * i] = (float)i;
+			((float*)buffer)[2 * i + 1] = -(float)i;
+			break;
+		case 5://complex_fp64
+			((double*)buffer)[2 * i] = (double)i;
+			((double*)buffer)[2 * i + 1] = -(double)i;
 			break;
 		}
 	}
-	free(queueFamilies);
-	if (i == queueFamilyCount) {
-		return VK_ERROR_INITIALIZATION_FAILED;
-	}
-	vkGPU->queueFamilyIndex = i;
-	return VK_SUCCESS;
-}
-VkResult createDevice(VkGPU* vkGPU) {
-	//create logical device representation
-	VkResult res = VK_SUCCESS;
-	VkDeviceQueueCreateInfo queueCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
-	res = getComputeQueueFamilyIndex(vkGPU);
-	if (res != VK_SUCCESS) return res;
-	queueCreateInfo.queueFamilyIndex = vkGPU->queueFamilyIndex;
-	queueCreateInfo.queueCount = 1;
-	float queuePriorities = 1.0;
-	queueCreateInfo.pQueuePriorities = &queuePriorities;
-	VkDeviceCreateInfo deviceCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
-	VkPhysicalDeviceFeatures deviceFeatures = { 0 };
-	deviceFeatures.shaderFloat64 = VK_TRUE;//this enables double precision support in shaders 
-	deviceCreateInfo.enabledExtensionCount = 0;
-	deviceCreateInfo.ppEnabledExtensionNames = NULL;
-	deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
-	deviceCreateInfo.queueCreateInfoCount = 1;
-	deviceCreateInfo.pEnabledFeatures = NULL;
-	deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
-	res = vkCreateDevice(vkGPU->physicalDevice, &deviceCreateInfo, NULL, &vkGPU->device);
-	if (res != VK_SUCCESS) return res;
-	vkGetDeviceQueue(vkGPU->device, vkGPU->queueFamilyIndex, 0, &vkGPU->queue);
-	return res;
-}
-VkResult createFence(VkGPU* vkGPU) {
-	//create fence for synchronization 
-	VkResult res = VK_SUCCESS;
-	VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
-	fenceCreateInfo.flags = 0;
-	res = vkCreateFence(vkGPU->device, &fenceCreateInfo, NULL, &vkGPU->fence);
-	return res;
-}
-VkResult createCommandPool(VkGPU* vkGPU) {
-	//create a place, command buffer memory is allocated from
-	VkResult res = VK_SUCCESS;
-	VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
-	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-	commandPoolCreateInfo.queueFamilyIndex = vkGPU->queueFamilyIndex;
-	res = vkCreateCommandPool(vkGPU->device, &commandPoolCreateInfo, NULL, &vkGPU->commandPool);
-	return res;
-}
-VkResult createShaderModule(VkGPU* vkGPU, VkShaderModule* shaderModule, uint32_t shaderID) {
-	//create shader module, using the SPIR-V bytecode
-	VkResult res = VK_SUCCESS;
-	char shaderPath[256];
-	//this sample uses two compute shaders, that can be selected by passing an appropriate id
-	switch (shaderID) {
-	case 0:
-		sprintf(shaderPath, "%stransposition_no_bank_conflicts.spv", SHADER_DIR);
-		break;
-	case 1:
-		sprintf(shaderPath, "%stransposition_bank_conflicts.spv", SHADER_DIR);
-		break;
-	case 2:
-		sprintf(shaderPath, "%stransfer.spv", SHADER_DIR);
-		break;
-	default:
-		return VK_ERROR_INITIALIZATION_FAILED;
-	}
-	uint32_t filelength;
-	//read bytecode
-	uint32_t* code = VkFFTReadShader(&filelength, shaderPath);
-	VkShaderModuleCreateInfo createInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
-	createInfo.pCode = code;
-	createInfo.codeSize = filelength;
-	res = vkCreateShaderModule(vkGPU->device, &createInfo, NULL, shaderModule);
-	free(code);
-	return res;
-}
-VkResult createApp(VkGPU* vkGPU, VkApplication* app, uint32_t shaderID) {
-	//create an application interface to Vulkan. This function binds the shader to the compute pipeline, so it can be used as a part of the command buffer later
-	VkResult res = VK_SUCCESS;
-	//we have two storage buffer objects in one set in one pool
-	VkDescriptorPoolSize descriptorPoolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
-	descriptorPoolSize.descriptorCount = 2;
-
-	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
-	descriptorPoolCreateInfo.poolSizeCount = 1;
-	descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
-	descriptorPoolCreateInfo.maxSets = 1;
-	res = vkCreateDescriptorPool(vkGPU->device, &descriptorPoolCreateInfo, NULL, &app->descriptorPool);
-	if (res != VK_SUCCESS) return res;
-	//specify each object from the set as a storage buffer
-	const VkDescriptorType descriptorType[2] = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
-	VkDescriptorSetLayoutBinding* descriptorSetLayoutBindings = (VkDescriptorSetLayoutBinding*)malloc(descriptorPoolSize.descriptorCount * sizeof(VkDescriptorSetLayoutBinding));
-	for (uint32_t i = 0; i < descriptorPoolSize.descriptorCount; ++i) {
-		descriptorSetLayoutBindings[i].binding = i;
-		descriptorSetLayoutBindings[i].descriptorType = descriptorType[i];
-		descriptorSetLayoutBindings[i].descriptorCount = 1;
-		descriptorSetLayoutBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-	}
-
-	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
-	descriptorSetLayoutCreateInfo.bindingCount = descriptorPoolSize.descriptorCount;
-	descriptorSetLayoutCreateInfo.pBindings = descriptorSetLayoutBindings;
-	//create layout
-	res = vkCreateDescriptorSetLayout(vkGPU->device, &descriptorSetLayoutCreateInfo, NULL, &app->descriptorSetLayout);
-	if (res != VK_SUCCESS) return res;
-	free(descriptorSetLayoutBindings);
-	//provide the layout with actual buffers and their sizes
-	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
-	descriptorSetAllocateInfo.descriptorPool = app->descriptorPool;
-	descriptorSetAllocateInfo.descriptorSetCount = 1;
-	descriptorSetAllocateInfo.pSetLayouts = &app->descriptorSetLayout;
-	res = vkAllocateDescriptorSets(vkGPU->device, &descriptorSetAllocateInfo, &app->descriptorSet);
-	if (res != VK_SUCCESS) return res;
-	for (uint32_t i = 0; i < descriptorPoolSize.descriptorCount; ++i) {
-
-
-		VkDescriptorBufferInfo descriptorBufferInfo = { 0 };
-		if (i == 0) {
-			descriptorBufferInfo.buffer = app->inputBuffer[0];
-			descriptorBufferInfo.range = app->inputBufferSize;
-			descriptorBufferInfo.offset = 0;
-		}
-		if (i == 1) {
-			descriptorBufferInfo.buffer = app->outputBuffer[0];
-			descriptorBufferInfo.range = app->outputBufferSize;
-			descriptorBufferInfo.offset = 0;
-		}
-
-		VkWriteDescriptorSet writeDescriptorSet = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
-		writeDescriptorSet.dstSet = app->descriptorSet;
-		writeDescriptorSet.dstBinding = i;
-		writeDescriptorSet.dstArrayElement = 0;
-		writeDescriptorSet.descriptorType = descriptorType[i];
-		writeDescriptorSet.descriptorCount = 1;
-		writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
-		vkUpdateDescriptorSets(vkGPU->device, 1, &writeDescriptorSet, 0, NULL);
-	}
-
-
-
-	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
-	pipelineLayoutCreateInfo.setLayoutCount = 1;
-	pipelineLayoutCreateInfo.pSetLayouts = &app->descriptorSetLayout;
-	//specify how many push constants can be specified when the pipeline is bound to the command buffer
-	VkPushConstantRange pushConstantRange = { VK_SHADER_STAGE_COMPUTE_BIT };
-	pushConstantRange.offset = 0;
-	pushConstantRange.size = sizeof(VkAppPushConstantsLayout);
-	pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
-	pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
-	//create pipeline layout
-	res = vkCreatePipelineLayout(vkGPU->device, &pipelineLayoutCreateInfo, NULL, &app->pipelineLayout);
-	if (res != VK_SUCCESS) return res;
-	VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
-
-	VkComputePipelineCreateInfo computePipelineCreateInfo = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
-	//specify specialization constants - structure that sets constants in the shader after first compilation (done by glslangvalidator, for example) but before final shader module creation
-	//first three values - workgroup dimensions 
-	app->specializationConstants.localSize[0] = app->coalescedMemory / sizeof(float);
-	app->specializationConstants.localSize[1] = app->coalescedMemory / sizeof(float);
-	app->specializationConstants.localSize[2] = 1;
-	//next three - buffer strides for multidimensional data
-	app->specializationConstants.inputStride[0] = 1;
-	app->specializationConstants.inputStride[1] = app->size[0];
-	app->specializationConstants.inputStride[2] = app->size[0]*app->size[1];
-
-	VkSpecializationMapEntry specializationMapEntries[6] = { 0 };
-	for (uint32_t i = 0; i < 6; i++) {
-		specializationMapEntries[i].constantID = i + 1;
-		specializationMapEntries[i].size = sizeof(uint32_t);
-		specializationMapEntries[i].offset = i * sizeof(uint32_t);
-	}
-	VkSpecializationInfo specializationInfo = { 0 };
-	specializationInfo.dataSize = 6 * sizeof(uint32_t);
-	specializationInfo.mapEntryCount = 6;
-	specializationInfo.pMapEntries = specializationMapEntries;
-	specializationInfo.pData = &app->specializationConstants;
-
-	pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-	//create a shader module from the byte code
-	res = createShaderModule(vkGPU, &pipelineShaderStageCreateInfo.module, shaderID);
-	if (res != VK_SUCCESS) return res;
-	pipelineShaderStageCreateInfo.pSpecializationInfo = &specializationInfo;
-	pipelineShaderStageCreateInfo.pName = "main";
-	computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
-	computePipelineCreateInfo.layout = app->pipelineLayout;
-	//create pipeline
-	res = vkCreateComputePipelines(vkGPU->device, VK_NULL_HANDLE, 1, &computePipelineCreateInfo, NULL, &app->pipeline);
-	if (res != VK_SUCCESS) return res;
-	vkDestroyShaderModule(vkGPU->device, pipelineShaderStageCreateInfo.module, NULL);
-	return res;
 }
-void appendApp(VkGPU* vkGPU, VkApplication* app, VkCommandBuffer* commandBuffer) {
-	//this function appends to the command buffer: push constants, binds pipeline, descriptors, the shader's program dispatch call and the barrier between two compute stages to avoid race conditions 
-	VkMemoryBarrier memory_barrier = {
-				VK_STRUCTURE_TYPE_MEMORY_BARRIER,
-				0,
-				VK_ACCESS_SHADER_WRITE_BIT,
-				VK_ACCESS_SHADER_READ_BIT,
-	};
-	app->pushConstants.pushID = 0;
-	//specify push constants - small amount of constant data in the shader
-	vkCmdPushConstants(commandBuffer[0], app->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkAppPushConstantsLayout), &app->pushConstants);
-	//bind compute pipeline to the command buffer
-	vkCmdBindPipeline(commandBuffer[0], VK_PIPELINE_BIND_POINT_COMPUTE, app->pipeline);
-	//bind descriptors to the command buffer
-	vkCmdBindDescriptorSets(commandBuffer[0], VK_PIPELINE_BIND_POINT_COMPUTE, app->pipelineLayout, 0, 1, &app->descriptorSet, 0, NULL);
-	//record dispatch call to the command buffer - specifies the total amount of workgroups
-	vkCmdDispatch(commandBuffer[0], app->size[0] / app->specializationConstants.localSize[0], app->size[1] / app->specializationConstants.localSize[1], app->size[2] / app->specializationConstants.localSize[2]);
-	//memory synchronization between two compute dispatches
-	vkCmdPipelineBarrier(commandBuffer[0], VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
-
-}
-VkResult runApp(VkGPU* vkGPU, VkApplication* app, uint32_t batch, double* time) {
+VkResult VulkanCPUTest(uint32_t sizeX, uint32_t sizeY, uint32_t dataType)
+{
+	//transpose a host matrix on the CPU with 1, 2, 4, ... threads up to the number of cores and report the bandwidth per thread count. Bandwidth counts both the read and the written matrix
 	VkResult res = VK_SUCCESS;
-	//create command buffer to be executed on the GPU
-	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
-	commandBufferAllocateInfo.commandPool = vkGPU->commandPool;
-	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	commandBufferAllocateInfo.commandBufferCount = 1;
-	VkCommandBuffer commandBuffer = {0};
-	res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &commandBuffer);
-	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
-	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-	//begin command buffer recording
-	res = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-	if (res != VK_SUCCESS) return res;
-	//Record commands batch times. Allows to perform multiple operations in one submit to mitigate dispatch overhead
-	for (uint32_t i = 0; i < batch; i++) {
-		appendApp(vkGPU, app, &commandBuffer);
+	uint32_t elementSize = dataTypes[dataType].size;
+	uint64_t numElements = (uint64_t)sizeX * sizeY;
+	uint64_t matrixSize = elementSize * numElements;
+	void* input = malloc(matrixSize);
+	void* output = malloc(matrixSize);
+	if ((input == NULL) || (output == NULL)) {
+		printf("Host matrix allocation failed, %d MB each\n", (int)(matrixSize / 1024 / 1024));
+		free(input);
+		free(output);
+		return VK_ERROR_OUT_OF_HOST_MEMORY;
 	}
-	//end command buffer recording
-	res = vkEndCommandBuffer(commandBuffer);
-	if (res != VK_SUCCESS) return res;
-	//submit the command buffer for execution and place the fence after, measure time required for execution
-	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &commandBuffer;
-	clock_t t;
-	t = clock();
-	res = vkQueueSubmit(vkGPU->queue, 1, &submitInfo, vkGPU->fence);
-	if (res != VK_SUCCESS) return res;
-	res = vkWaitForFences(vkGPU->device, 1, &vkGPU->fence, VK_TRUE, 100000000000);
-	if (res != VK_SUCCESS) return res;
-	t = clock() - t;
-	time[0] = ((double)t) / CLOCKS_PER_SEC * 1000/batch; //in ms
-	res = vkResetFences(vkGPU->device, 1, &vkGPU->fence);
-	if (res != VK_SUCCESS) return res;
-	//free the command buffer
-	vkFreeCommandBuffers(vkGPU->device, vkGPU->commandPool, 1, &commandBuffer);
-	return res;
-}
-void deleteApp(VkGPU* vkGPU, VkApplication* app) {
-	//destroy previously allocated resources of the application
-	vkDestroyDescriptorPool(vkGPU->device, app->descriptorPool, NULL);
-	vkDestroyDescriptorSetLayout(vkGPU->device, app->descriptorSetLayout, NULL);
-	vkDestroyPipelineLayout(vkGPU->device, app->pipelineLayout, NULL);
-	vkDestroyPipeline(vkGPU->device, app->pipeline, NULL);
-}
-VkResult findMemoryType(VkGPU* vkGPU, uint32_t memoryTypeBits, VkMemoryPropertyFlags properties, uint32_t* memoryTypeIndex) {
-	//find memory with specified properties
-	VkPhysicalDeviceMemoryProperties memoryProperties = { 0 };
-
-	vkGetPhysicalDeviceMemoryProperties(vkGPU->physicalDevice, &memoryProperties);
-
-	for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
-		if ((memoryTypeBits & (1 << i)) && ((memoryProperties.memoryTypes[i].propertyFlags & properties) == properties))
-		{
-			memoryTypeIndex[0] = i;
-			return VK_SUCCESS;
+	fillInputData(input, dataType, numElements);
+	VkApplication app = { 0 };
+	app.size[0] = sizeX;
+	app.size[1] = sizeY;
+	app.size[2] = 1;
+	app.dataType = dataType;
+	uint32_t numCores = getCoreCount();
+	printf("CPU transposition, data type: %s (%d bytes), system size: %dx%d, kernel: %s, cores: %d\n", dataTypes[dataType].name, elementSize, sizeX, sizeY, getCPUKernelName(dataType), numCores);
+	double singleTime = 0;
+	uint32_t errors = 0;
+	for (uint32_t numThreads = 1; ; numThreads = (numThreads * 2 < numCores) ? numThreads * 2 : numCores) {
+		//the first call warms up the caches and touches the output pages, the best of 5 calls is reported
+		double bestTime = 0;
+		for (uint32_t i = 0; i < 6; i++) {
+			double start = getWallTime();
+			res = cpuApp(&app, input, output, numThreads);
+			if (res != VK_SUCCESS) {
+				printf("CPU transposition failed, error code: %d\n", res);
+				free(input);
+				free(output);
+				return res;
+			}
+			double time = getWallTime() - start;
+			if ((i == 1) || ((i > 1) && (time < bestTime))) bestTime = time;
 		}
+		if (numThreads == 1) singleTime = bestTime;
+		double bandwidth = 2 * matrixSize / 1024.0 / 1024.0 / 1024.0 / bestTime * 1000;
+		printf("%d thread(s): %.3f ms, %.2f GB/s, %.2f GB/s per core, speedup %.2f\n", numThreads, bestTime, bandwidth, bandwidth / numThreads, singleTime / bestTime);
+		if (numThreads == numCores) break;
 	}
-	return VK_ERROR_INITIALIZATION_FAILED;
-}
-VkResult allocateFFTBuffer(VkGPU* vkGPU, VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags, VkDeviceSize size) {
-	//allocate the buffer used by the GPU with specified properties
-	VkResult res = VK_SUCCESS;
-	uint32_t queueFamilyIndices;
-	VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
-	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-	bufferCreateInfo.queueFamilyIndexCount = 1;
-	bufferCreateInfo.pQueueFamilyIndices = &queueFamilyIndices;
-	bufferCreateInfo.size = size;
-	bufferCreateInfo.usage = usageFlags;
-	res = vkCreateBuffer(vkGPU->device, &bufferCreateInfo, NULL, buffer);
-	if (res != VK_SUCCESS) return res;
-	VkMemoryRequirements memoryRequirements = { 0 };
-	vkGetBufferMemoryRequirements(vkGPU->device, buffer[0], &memoryRequirements);
-	VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
-	memoryAllocateInfo.allocationSize = memoryRequirements.size;
-	res = findMemoryType(vkGPU, memoryRequirements.memoryTypeBits, propertyFlags, &memoryAllocateInfo.memoryTypeIndex);
-	if (res != VK_SUCCESS) return res;
-	res = vkAllocateMemory(vkGPU->device, &memoryAllocateInfo, NULL, deviceMemory);
-	if (res != VK_SUCCESS) return res;
-	res = vkBindBufferMemory(vkGPU->device, buffer[0], deviceMemory[0], 0);
-	if (res != VK_SUCCESS) return res;
-	return res;
-}
-VkResult transferDataFromCPU(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
-	//a function that transfers data from the CPU to the GPU using staging buffer, because the GPU memory is not host-coherent
-	VkResult res = VK_SUCCESS;
-	VkDeviceSize stagingBufferSize = bufferSize;
-	VkBuffer stagingBuffer = { 0 };
-	VkDeviceMemory stagingBufferMemory = { 0 };
-	res = allocateFFTBuffer(vkGPU, &stagingBuffer, &stagingBufferMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBufferSize);
-	if (res != VK_SUCCESS) return res;
-	void* data;
-	res = vkMapMemory(vkGPU->device, stagingBufferMemory, 0, stagingBufferSize, 0, &data);
-	if (res != VK_SUCCESS) return res;
-	memcpy(data, arr, stagingBufferSize);
-	vkUnmapMemory(vkGPU->device, stagingBufferMemory);
-	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
-	commandBufferAllocateInfo.commandPool = vkGPU->commandPool;
-	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	commandBufferAllocateInfo.commandBufferCount = 1;
-	VkCommandBuffer commandBuffer = { 0 };
-	res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &commandBuffer);
-	if (res != VK_SUCCESS) return res;
-	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
-	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-	res = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-	if (res != VK_SUCCESS) return res;
-	VkBufferCopy copyRegion = { 0 };
-	copyRegion.srcOffset = 0;
-	copyRegion.dstOffset = 0;
-	copyRegion.size = stagingBufferSize;
-	vkCmdCopyBuffer(commandBuffer, stagingBuffer, buffer[0], 1, &copyRegion);
-	res = vkEndCommandBuffer(commandBuffer);
-	if (res != VK_SUCCESS) return res;
-	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &commandBuffer;
-	res = vkQueueSubmit(vkGPU->queue, 1, &submitInfo, vkGPU->fence);
-	if (res != VK_SUCCESS) return res;
-	res = vkWaitForFences(vkGPU->device, 1, &vkGPU->fence, VK_TRUE, 100000000000);
-	if (res != VK_SUCCESS) return res;
-	res = vkResetFences(vkGPU->device, 1, &vkGPU->fence);
-	if (res != VK_SUCCESS) return res;
-	vkFreeCommandBuffers(vkGPU->device, vkGPU->commandPool, 1, &commandBuffer);
-	vkDestroyBuffer(vkGPU->device, stagingBuffer, NULL);
-	vkFreeMemory(vkGPU->device, stagingBufferMemory, NULL);
-	return res;
-}
-VkResult transferDataToCPU(VkGPU* vkGPU, void* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
-	//a function that transfers data from the GPU to the CPU using staging buffer, because the GPU memory is not host-coherent
-	VkResult res = VK_SUCCESS;
-	VkDeviceSize stagingBufferSize = bufferSize;
-	VkBuffer stagingBuffer = { 0 };
-	VkDeviceMemory stagingBufferMemory = { 0 };
-	res = allocateFFTBuffer(vkGPU, &stagingBuffer, &stagingBufferMemory, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBufferSize);
-	if (res != VK_SUCCESS) return res;
-	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
-	commandBufferAllocateInfo.commandPool = vkGPU->commandPool;
-	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	commandBufferAllocateInfo.commandBufferCount = 1;
-	VkCommandBuffer commandBuffer = { 0 };
-	res = vkAllocateCommandBuffers(vkGPU->device, &commandBufferAllocateInfo, &commandBuffer);
-	if (res != VK_SUCCESS) return res;
-	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
-	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-	res = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-	if (res != VK_SUCCESS) return res;
-	VkBufferCopy copyRegion = { 0 };
-	copyRegion.srcOffset = 0;
-	copyRegion.dstOffset = 0;
-	copyRegion.size = stagingBufferSize;
-	vkCmdCopyBuffer(commandBuffer, buffer[0], stagingBuffer, 1, &copyRegion);
-	vkEndCommandBuffer(commandBuffer);
-	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &commandBuffer;
-	res = vkQueueSubmit(vkGPU->queue, 1, &submitInfo, vkGPU->fence);
-	if (res != VK_SUCCESS) return res;
-	res = vkWaitForFences(vkGPU->device, 1, &vkGPU->fence, VK_TRUE, 100000000000);
-	if (res != VK_SUCCESS) return res;
-	res = vkResetFences(vkGPU->device, 1, &vkGPU->fence);
-	if (res != VK_SUCCESS) return res;
-	vkFreeCommandBuffers(vkGPU->device, vkGPU->commandPool, 1, &commandBuffer);
-	void* data;
-	res = vkMapMemory(vkGPU->device, stagingBufferMemory, 0, stagingBufferSize, 0, &data);
-	if (res != VK_SUCCESS) return res;
-	memcpy(arr, data, stagingBufferSize);
-	vkUnmapMemory(vkGPU->device, stagingBufferMemory);
-	vkDestroyBuffer(vkGPU->device, stagingBuffer, NULL);
-	vkFreeMemory(vkGPU->device, stagingBufferMemory, NULL);
-	return res;
-}
-
-VkResult devices_list() {
-	//this function creates an instance and prints the list of available devices
-	VkResult res = VK_SUCCESS;
-	VkInstance local_instance = {0};
-	VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
-	createInfo.flags = 0;
-	createInfo.pApplicationInfo = NULL;
-	VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo = { VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT };
-	createInfo.enabledLayerCount = 0;
-	createInfo.enabledExtensionCount = 0;
-	createInfo.pNext = NULL;
-	res = vkCreateInstance(&createInfo, NULL, &local_instance);
-	if (res != VK_SUCCESS) return res;
-
-	uint32_t deviceCount;
-	res = vkEnumeratePhysicalDevices(local_instance, &deviceCount, NULL);
-	if (res != VK_SUCCESS) return res;
-
-	VkPhysicalDevice* devices=(VkPhysicalDevice *) malloc(sizeof(VkPhysicalDevice)*deviceCount);
-	res = vkEnumeratePhysicalDevices(local_instance, &deviceCount, devices);
-	if (res != VK_SUCCESS) return res;
-	for (uint32_t i = 0; i < deviceCount; i++) {
-		VkPhysicalDeviceProperties device_properties;
-		vkGetPhysicalDeviceProperties(devices[i], &device_properties);
-		printf("Device id: %d name: %s API:%d.%d.%d\n", i, device_properties.deviceName, (device_properties.apiVersion >> 22), ((device_properties.apiVersion >> 12) & 0x3ff), (device_properties.apiVersion & 0xfff));
+	//check every element: output element (j, i) is the input element (i, j)
+	for (uint64_t id = 0; id < numElements; id++) {
+		uint64_t i = id % sizeX;
+		uint64_t j = id / sizeX;
+		if (memcmp((char*)output + (i * sizeY + j) * elementSize, (char*)input + id * elementSize, elementSize) != 0) errors++;
 	}
-	free(devices);
-	vkDestroyInstance(local_instance, NULL);
+	printf("Elements check: %s\n", (errors) ? "failed" : "passed");
+	free(input);
+	free(output);
+	if (errors) return VK_ERROR_INITIALIZATION_FAILED;
 	return res;
 }
-
-VkResult VulkanTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t size)
+VkResult VulkanTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t sizeX, uint32_t sizeY, uint32_t dataType, uint32_t tileDim, uint32_t blockRows, uint32_t vectorWidth, uint32_t tileOrder, const char* tuningPath, const char* pipelineCachePath)
 {
 	VkGPU vkGPU = { 0 };
 	vkGPU.device_id = deviceID;
+	vkGPU.pipelineCachePath = pipelineCachePath;
+	//if no tile configuration is specified, createApp loads the tuned one and the faster shader from the tuning database
+	if ((tileDim == 0) && (blockRows == 0) && (vectorWidth == 0)) vkGPU.tuningPath = tuningPath;
 	VkResult res = VK_SUCCESS;
-	//create instance - a connection between the application and the Vulkan library 
-	res = createInstance(&vkGPU);
-	if (res != VK_SUCCESS) {
-		printf("Instance creation failed, error code: %d\n", res);
-		return res;
-	}
-	//set up the debugging messenger 
-	res = setupDebugMessenger(&vkGPU);
-	if (res != VK_SUCCESS) {
-		printf("Debug messenger creation failed, error code: %d\n", res);
-		return res;
-	}
-	//check if there are GPUs that support Vulkan and select one
-	res = findPhysicalDevice(&vkGPU);
-	if (res != VK_SUCCESS) {
-		printf("Physical device not found, error code: %d\n", res);
-		return res;
-	}
-	//create logical device representation
-	res = createDevice(&vkGPU);
-	if (res != VK_SUCCESS) {
-		printf("Device creation failed, error code: %d\n", res);
-		return res;
-	}
-	//create fence for synchronization 
-	res = createFence(&vkGPU);
-	if (res != VK_SUCCESS) {
-		printf("Fence creation failed, error code: %d\n", res);
-		return res;
-	}
-	//create a place, command buffer memory is allocated from
-	res = createCommandPool(&vkGPU);
+	//create instance, device and all other Vulkan primitives of the GPU. Hosts without a usable Vulkan device transpose on the CPU
+	res = createGPU(&vkGPU);
 	if (res != VK_SUCCESS) {
-		printf("Fence creation failed, error code: %d\n", res);
-		return res;
+		printf("No Vulkan device is available, error code: %d. Falling back to the CPU transposition\n", res);
+		return VulkanCPUTest(sizeX, sizeY, dataType);
 	}
-	//get device properties and memory properties, if needed
-	vkGetPhysicalDeviceProperties(vkGPU.physicalDevice, &vkGPU.physicalDeviceProperties);
-	vkGetPhysicalDeviceMemoryProperties(vkGPU.physicalDevice, &vkGPU.physicalDeviceMemoryProperties);
 	//create app template and set the system size, the amount of memory to coalesce
 	VkApplication app = { 0 };
-	app.size[0] = size;
-	app.size[1] = size;
+	app.size[0] = sizeX;
+	app.size[1] = sizeY;
 	app.size[2] = 1;
+	app.dataType = dataType;
+	uint32_t elementSize = dataTypes[dataType].size;
+	//tile configuration of the 2D shaders, 0 - default (the tuned one, if the tuning database has it)
+	app.tileDim = tileDim;
+	app.blockRows = blockRows;
+	app.vectorWidth = vectorWidth;
+	app.tileOrder = tileOrder;
 	//use default values if coalescedMemory = 0
-	if (coalescedMemory == 0) {
-		switch (vkGPU.physicalDeviceProperties.vendorID) {
-		case 0x10DE://NVIDIA - change to 128 before Pascal
-			app.coalescedMemory = 32;
-			break;
-		case 0x8086://INTEL
-			app.coalescedMemory = 64;
-			break;
-		case 0x13B5://AMD
-			app.coalescedMemory = 64;
-			break;
-		default:
-			app.coalescedMemory = 64;
-			break;
-		}
-	}
+	if (coalescedMemory == 0)
+		app.coalescedMemory = defaultCoalescedMemory(&vkGPU);
 	else
 		app.coalescedMemory = coalescedMemory;
 	//allocate input and output buffers
-	VkDeviceSize inputBufferSize=sizeof(float)* app.size[0] * app.size[1] * app.size[2];
+	VkDeviceSize inputBufferSize=(VkDeviceSize)elementSize * app.size[0] * app.size[1] * app.size[2];
 	VkBuffer inputBuffer = { 0 };
 	VkDeviceMemory inputBufferDeviceMemory = { 0 };
 
-	VkDeviceSize outputBufferSize=sizeof(float) * app.size[0] * app.size[1] * app.size[2];
+	VkDeviceSize outputBufferSize=(VkDeviceSize)elementSize * app.size[0] * app.size[1] * app.size[2];
 	VkBuffer outputBuffer = { 0 };
 	VkDeviceMemory outputBufferDeviceMemory = { 0 };
 
-	res = allocateFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, inputBufferSize);
+	res = allocateFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, inputBufferSize);
 	if (res != VK_SUCCESS) {
 		printf("Input buffer allocation failed, error code: %d\n", res);
 		return res;
 	}
-	res = allocateFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, outputBufferSize);
+	res = allocateFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, outputBufferSize);
 	if (res != VK_SUCCESS) {
 		printf("Output buffer allocation failed, error code: %d\n", res);
 		return res;
@@ -731,11 +162,48 @@ VkResult VulkanTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t size)
 	app.outputBufferSize = outputBufferSize;
 	app.outputBuffer = &outputBuffer;
 	app.outputBufferDeviceMemory = &outputBufferDeviceMemory;
-	//copy app for bank conflicted shared memory sample and bandwidth sample
+	//copy app for bank conflicted shared memory sample and bandwidth sample, and a template for the apps created for each buffer pair in the setup cost measurement
+	VkApplication app_template = app;
 	VkApplication app_bank_conflicts = app;
 	VkApplication app_bandwidth = app;
-	//create transposition app with no bank conflicts from transposition shader
+	VkApplication app_subgroup = app;
+	//in-place app reads and writes the input buffer. Square matrices swap tile pairs, rectangular matrices are permuted with a small scratch buffer
+	VkApplication app_in_place = app;
+	uint32_t inPlaceShaderID = (app.size[0] == app.size[1]) ? 4 : 5;
+	VkBuffer scratchBuffer = { 0 };
+	VkDeviceMemory scratchBufferDeviceMemory = { 0 };
+	VkDeviceSize scratchBufferSize = 0;
+	if (inPlaceShaderID == 4) {
+		app_in_place.outputBuffer = &inputBuffer;
+		app_in_place.outputBufferSize = inputBufferSize;
+	}
+	else {
+		app_in_place.scratchLines = 64;
+		scratchBufferSize = (VkDeviceSize)elementSize * app_in_place.scratchLines * ((app.size[0] > app.size[1]) ? app.size[0] : app.size[1]);
+		res = allocateFFTBuffer(&vkGPU, &scratchBuffer, &scratchBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, scratchBufferSize);
+		if (res != VK_SUCCESS) {
+			printf("Scratch buffer allocation failed, error code: %d\n", res);
+			return res;
+		}
+		app_in_place.outputBuffer = &scratchBuffer;
+		app_in_place.outputBufferSize = scratchBufferSize;
+		app_in_place.outputBufferDeviceMemory = &scratchBufferDeviceMemory;
+	}
+	//create transposition app with no bank conflicts from transposition shader. Pipeline creation is timed to show the effect of the pipeline cache
+	double pipelineStart = getWallTime();
 	res = createApp(&vkGPU, &app, 0);
+	if (res == VK_ERROR_FEATURE_NOT_PRESENT) {
+		//nothing has run yet, so only the buffers, the partially created app and the device are released
+		printf("Data type %s is not supported by the device\n", dataTypes[dataType].name);
+		deleteApp(&vkGPU, &app);
+		freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+		freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+		if (inPlaceShaderID == 5) {
+			freeFFTBuffer(&vkGPU, &scratchBuffer, &scratchBufferDeviceMemory);
+		}
+		deleteGPU(&vkGPU);
+		return res;
+	}
 	if (res != VK_SUCCESS) {
 		printf("Application creation failed, error code: %d\n", res);
 		return res;
@@ -752,32 +220,65 @@ VkResult VulkanTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t size)
 		printf("Application creation failed, error code: %d\n", res);
 		return res;
 	}
+	//create subgroup shuffle transposition app, if the device supports shuffles in compute shaders
+	VkResult resSubgroup = createApp(&vkGPU, &app_subgroup, 7);
+	if ((resSubgroup != VK_SUCCESS) && (resSubgroup != VK_ERROR_FEATURE_NOT_PRESENT)) {
+		printf("Application creation failed, error code: %d\n", resSubgroup);
+		return resSubgroup;
+	}
+	//create in-place transposition app
+	res = createApp(&vkGPU, &app_in_place, inPlaceShaderID);
+	if (res != VK_SUCCESS) {
+		printf("Application creation failed, error code: %d\n", res);
+		return res;
+	}
+	double pipelineTime = getWallTime() - pipelineStart;
+	uint32_t numPipelines = (resSubgroup == VK_SUCCESS) ? 5 : 4;
 	//allocate input data on the CPU
-	float* buffer_input = (float*)malloc(inputBufferSize);
-
-	for (uint32_t k = 0; k < app.size[2]; k++) {
-		for (uint32_t j = 0; j < app.size[1]; j++) {
-			for (uint32_t i = 0; i < app.size[0]; i++) {
-				buffer_input[ (i + j * app.size[0] + k * (app.size[0]) * app.size[1])] = (i + j * app.size[0] + k * (app.size[0]) * app.size[1]);
-			}
+	void* buffer_input = malloc(inputBufferSize);
+	fillInputData(buffer_input, dataType, (uint64_t)app.size[0] * app.size[1] * app.size[2]);
+	//transfer data to the GPU through the staging ring of the GPU, the time includes the copy to the staging buffer
+	double uploadTime = getWallTime();
+	res = transferDataFromCPU(&vkGPU,buffer_input, &inputBuffer, inputBufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Upload failed, error code: %d\n", res);
+		return res;
+	}
+	uploadTime = getWallTime() - uploadTime;
+	//CPU baseline on all cores, the best of 5 calls after a warm-up call
+	void* buffer_cpu_output = malloc(outputBufferSize);
+	double timeCPU = 0;
+	for (uint32_t i = 0; (i < 6) && (buffer_cpu_output != NULL); i++) {
+		double start = getWallTime();
+		res = cpuApp(&app_template, buffer_input, buffer_cpu_output, 0);
+		if (res != VK_SUCCESS) {
+			printf("CPU transposition failed, error code: %d\n", res);
+			return res;
 		}
+		double time = getWallTime() - start;
+		if ((i == 1) || ((i > 1) && (time < timeCPU))) timeCPU = time;
 	}
-	//transfer data to the GPU
-	transferDataFromCPU(&vkGPU,buffer_input, &inputBuffer, inputBufferSize);
+	free(buffer_cpu_output);
 	free(buffer_input);
-	double time_no_bank_conflicts = 0;
-	double time_bank_conflicts = 0;
-	double time_bandwidth = 0;
+	VkAppTimings time_no_bank_conflicts = { 0 };
+	VkAppTimings time_bank_conflicts = { 0 };
+	VkAppTimings time_bandwidth = { 0 };
 	//perform transposition with no bank conflicts on the input buffer and store it in the output 1000 times
 	res = runApp(&vkGPU, &app, 1000, &time_no_bank_conflicts);
 	if (res != VK_SUCCESS) {
 		printf("Application 0 run failed, error code: %d\n", res);
 		return res;
 	}
-	float* buffer_output = (float*)malloc(outputBufferSize);
+	float* buffer_output = (float*)malloc(outputBufferSize);//only printed as fp32 below
 
 	//Transfer data from GPU using staging buffer, if needed
-	transferDataToCPU(&vkGPU, buffer_output, &outputBuffer, outputBufferSize);
+	double downloadTime = getWallTime();
+	res = transferDataToCPU(&vkGPU, buffer_output, &outputBuffer, outputBufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Download failed, error code: %d\n", res);
+		return res;
+	}
+	downloadTime = getWallTime() - downloadTime;
 	//Print data, if needed.
 	/*for (uint32_t k = 0; k < app.size[2]; k++) {
 		for (uint32_t j = 0; j < app.size[1]; j++) {
@@ -800,55 +301,1489 @@ VkResult VulkanTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t size)
 		printf("Application 2 run failed, error code: %d\n", res);
 		return res;
 	}
-	//print results
-	printf("Transpose time with no bank conflicts: %.3f ms\nTranspose time with bank conflicts: %.3f ms\nTransfer time: %.3f ms\nCoalesced Memory: %d bytes\nSystem size: %dx%d\nBuffer size: %d KB\nBandwidth: %d GB/s\nTranfer time/total transpose time: %0.3f%%\n", time_no_bank_conflicts, time_bank_conflicts, time_bandwidth, app.coalescedMemory, app.size[0], app.size[1],inputBufferSize / 1024, (int)(2*1000*inputBufferSize / 1024.0 / 1024.0 / 1024.0 /time_bandwidth), time_bandwidth/ time_no_bank_conflicts *100);
+	//perform transposition with subgroup shuffles 1000 times, it is compared to the padded shared memory transposition
+	VkAppTimings time_subgroup = { 0 };
+	if (resSubgroup == VK_SUCCESS) {
+		res = runApp(&vkGPU, &app_subgroup, 1000, &time_subgroup);
+		if (res != VK_SUCCESS) {
+			printf("Application 7 run failed, error code: %d\n", res);
+			return res;
+		}
+	}
+	//host cost of a single transposition call: recording the command buffer again for each call against resubmitting the command buffer recorded once. Both paths only record, submit and wait for the fence
+	double callStart = getWallTime();
+	for (uint32_t i = 0; i < 100; i++) {
+		res = recordApp(&vkGPU, &app);
+		if (res != VK_SUCCESS) {
+			printf("Application 0 recording failed, error code: %d\n", res);
+			return res;
+		}
+		res = executeApp(&vkGPU, &app);
+		if (res != VK_SUCCESS) {
+			printf("Application 0 run failed, error code: %d\n", res);
+			return res;
+		}
+	}
+	double timeRecordedEachCall = (getWallTime() - callStart) / 100;
+	callStart = getWallTime();
+	for (uint32_t i = 0; i < 100; i++) {
+		res = executeApp(&vkGPU, &app);
+		if (res != VK_SUCCESS) {
+			printf("Application 0 run failed, error code: %d\n", res);
+			return res;
+		}
+	}
+	double timePreRecorded = (getWallTime() - callStart) / 100;
+	//per-call setup cost of a transposition of a new buffer pair: creating a new app for each pair (the pipeline comes from the warm pipeline cache) against binding the pair to the existing app.
+	//two separately allocated pairs alternate, so the input of the other applications is never written
+	VkBuffer pairBuffers[4] = { 0 };
+	VkDeviceMemory pairBufferDeviceMemory[4] = { 0 };
+	for (uint32_t i = 0; i < 4; i++) {
+		res = allocateFFTBuffer(&vkGPU, &pairBuffers[i], &pairBufferDeviceMemory[i], VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, (i < 2) ? inputBufferSize : outputBufferSize);
+		if (res != VK_SUCCESS) {
+			printf("Buffer pair allocation failed, error code: %d\n", res);
+			return res;
+		}
+	}
+	VkBuffer* pairInput[2] = { &pairBuffers[0], &pairBuffers[1] };
+	VkBuffer* pairOutput[2] = { &pairBuffers[2], &pairBuffers[3] };
+	double setupCreate = 0;
+	callStart = getWallTime();
+	for (uint32_t i = 0; i < 20; i++) {
+		VkApplication app_pair = app_template;
+		app_pair.inputBuffer = pairInput[i % 2];
+		app_pair.outputBuffer = pairOutput[i % 2];
+		double setupStart = getWallTime();
+		res = createApp(&vkGPU, &app_pair, 0);
+		if (res != VK_SUCCESS) {
+			printf("Application creation failed, error code: %d\n", res);
+			return res;
+		}
+		setupCreate += getWallTime() - setupStart;
+		res = executeApp(&vkGPU, &app_pair);
+		if (res != VK_SUCCESS) {
+			printf("Application 0 run failed, error code: %d\n", res);
+			return res;
+		}
+		deleteApp(&vkGPU, &app_pair);
+	}
+	double timeCreateEachCall = (getWallTime() - callStart) / 20;
+	setupCreate /= 20;
+	double setupBind = 0;
+	callStart = getWallTime();
+	for (uint32_t i = 0; i < 100; i++) {
+		double setupStart = getWallTime();
+		res = bindApp(&vkGPU, &app, pairInput[i % 2], inputBufferSize, pairOutput[i % 2], outputBufferSize);
+		if (res != VK_SUCCESS) {
+			printf("Application 0 buffer binding failed, error code: %d\n", res);
+			return res;
+		}
+		setupBind += getWallTime() - setupStart;
+		res = executeApp(&vkGPU, &app);
+		if (res != VK_SUCCESS) {
+			printf("Application 0 run failed, error code: %d\n", res);
+			return res;
+		}
+	}
+	double timeBindEachCall = (getWallTime() - callStart) / 100;
+	setupBind /= 100;
+	//the application returns to the original buffers before the pairs are released
+	res = bindApp(&vkGPU, &app, &inputBuffer, inputBufferSize, &outputBuffer, outputBufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Application 0 buffer binding failed, error code: %d\n", res);
+		return res;
+	}
+	for (uint32_t i = 0; i < 4; i++)
+		freeFFTBuffer(&vkGPU, &pairBuffers[i], &pairBufferDeviceMemory[i]);
+	//bandwidth probes on the same buffers: the best copy is the roofline of the transposition, the worst strided access is what a transposition without tiling would achieve
+	VkAppBandwidth bandwidth = { 0 };
+	VkResult resBandwidth = measureBandwidth(&vkGPU, &inputBuffer, &outputBuffer, inputBufferSize, 100, &bandwidth);
+	//allocation cost of many small buffers (64 KB each), sub-allocated from blocks and with one vkAllocateMemory per buffer
+	uint64_t benchmarkAllocations[2] = { 0 };
+	double benchmarkAllocationTime[2] = { 0 };
+	for (uint32_t dedicated = 0; dedicated < 2; dedicated++) {
+		VkBuffer smallBuffers[256];
+		VkDeviceMemory smallBufferDeviceMemory[256];
+		uint64_t allocationsStart = vkGPU.memoryAllocationCount;
+		double allocationStart = getWallTime();
+		vkGPU.dedicatedMemory = dedicated;
+		for (uint32_t i = 0; i < 256; i++) {
+			res = allocateFFTBuffer(&vkGPU, &smallBuffers[i], &smallBufferDeviceMemory[i], VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 64 * 1024);
+			if (res != VK_SUCCESS) {
+				printf("Small buffer allocation failed, error code: %d\n", res);
+				return res;
+			}
+		}
+		for (uint32_t i = 0; i < 256; i++)
+			freeFFTBuffer(&vkGPU, &smallBuffers[i], &smallBufferDeviceMemory[i]);
+		benchmarkAllocationTime[dedicated] = getWallTime() - allocationStart;
+		benchmarkAllocations[dedicated] = vkGPU.memoryAllocationCount - allocationsStart;
+	}
+	vkGPU.dedicatedMemory = 0;
+	//perform in-place transposition of the input buffer 1000 times. It is done last, as it modifies the input
+	VkAppTimings time_in_place = { 0 };
+	res = runApp(&vkGPU, &app_in_place, 1000, &time_in_place);
+	if (res != VK_SUCCESS) {
+		printf("Application %d run failed, error code: %d\n", inPlaceShaderID, res);
+		return res;
+	}
+	//print results, bandwidth and time ratio are computed from the median per-dispatch time
+	printf("Data type: %s (%d bytes)\n", dataTypes[dataType].name, elementSize);
+	printf("Tile: %dx%d elements, workgroup: %dx%d threads, vector width: %d, tile order: %s (%s)\n", app.tileDim, app.tileDim, app.specializationConstants.localSize[0], app.specializationConstants.localSize[1], app.vectorWidth, tileOrderNames[app.tileOrder], (app.tuned) ? ((app.shaderID == 0) ? "tuned, padded shared memory is faster" : "tuned, unpadded shared memory is faster") : "not tuned");
+	if (vkGPU.pipelineCacheLoadedSize > 0)
+		printf("Pipeline creation time: %.3f ms for %d pipelines (warm cache, %d KB loaded)\n", pipelineTime, numPipelines, (int)(vkGPU.pipelineCacheLoadedSize / 1024));
+	else
+		printf("Pipeline creation time: %.3f ms for %d pipelines (cold cache)\n", pipelineTime, numPipelines);
+	printf("Host transfers (%s queue): upload %.3f ms, %.2f GB/s, download %.3f ms, %.2f GB/s\n", (vkGPU.transferQueueFamilyIndex != vkGPU.queueFamilyIndex) ? "dedicated transfer" : "compute", uploadTime, inputBufferSize / 1024.0 / 1024.0 / 1024.0 / uploadTime * 1000, downloadTime, outputBufferSize / 1024.0 / 1024.0 / 1024.0 / downloadTime * 1000);
+	printf("Device memory: %d vkAllocateMemory calls for %d buffers, %.3f ms spent in allocations\n", (int)vkGPU.memoryAllocationCount, (int)vkGPU.bufferAllocationCount, vkGPU.memoryAllocationTime);
+	printf("256 buffers of 64 KB allocated and freed: %.3f ms with %d vkAllocateMemory calls sub-allocated, %.3f ms with %d calls dedicated\n", benchmarkAllocationTime[0], (int)benchmarkAllocations[0], benchmarkAllocationTime[1], (int)benchmarkAllocations[1]);
+	printf("Timer: %s\n", (time_bandwidth.gpuTimestamps) ? "GPU timestamps" : "host wall clock (no timestamp support on the queue)");
+	printTimings("Transpose time with no bank conflicts", &time_no_bank_conflicts);
+	printTimings("Transpose time with bank conflicts", &time_bank_conflicts);
+	printTimings("Transfer time", &time_bandwidth);
+	if (resSubgroup == VK_SUCCESS) {
+		printTimings("Transpose time with subgroup shuffles", &time_subgroup);
+		printf("	subgroup size: %d, speedup over padded shared memory: %.2f\n", app_subgroup.tileDim, time_no_bank_conflicts.median / time_subgroup.median);
+	}
+	else
+		printf("Transpose with subgroup shuffles: not supported by the device\n");
+	printTimings((inPlaceShaderID == 4) ? "In-place transpose time" : "In-place rectangular transpose time", &time_in_place);
+	printf("Single transpose call: %.3f ms with a command buffer recorded for each call, %.3f ms with a pre-recorded command buffer. Host overhead over GPU time: %.3f ms and %.3f ms\n", timeRecordedEachCall, timePreRecorded, timeRecordedEachCall - time_no_bank_conflicts.median, timePreRecorded - time_no_bank_conflicts.median);
+	printf("Transpose call on a new buffer pair: %.3f ms (setup %.3f ms) creating an app for each pair, %.3f ms (setup %.3f ms) binding the pair to one app\n", timeCreateEachCall, setupCreate, timeBindEachCall, setupBind);
+	printf("Transpose bandwidth with no bank conflicts: %d GB/s\n", (int)(2 * 1000 * inputBufferSize / 1024.0 / 1024.0 / 1024.0 / time_no_bank_conflicts.median));
+	if (resBandwidth == VK_SUCCESS) {
+		printf("Bandwidth probes: vec4 copy %.2f GB/s, vkCmdCopyBuffer %.2f GB/s, read-only %.2f GB/s, write-only %.2f GB/s\n", bandwidth.copy, bandwidth.copyBuffer, bandwidth.read, bandwidth.write);
+		printf("Strided read / strided write:");
+		for (uint32_t i = 0; i < VK_APP_NUM_PROBE_STRIDES; i++)
+			printf(" stride %d: %.2f / %.2f GB/s%s", bandwidth.strides[i], bandwidth.stridedRead[i], bandwidth.stridedWrite[i], (i + 1 < VK_APP_NUM_PROBE_STRIDES) ? "," : "\n");
+		//each kernel is placed between the worst strided access (no tiling) and the best copy (the roofline)
+		VkAppTimings* kernelTimings[5] = { &time_no_bank_conflicts, &time_bank_conflicts, &time_bandwidth, &time_in_place, &time_subgroup };
+		const char* kernelNames[5] = { "no bank conflicts", "bank conflicts", "transfer", "in-place", "subgroup shuffles" };
+		for (uint32_t i = 0; i < ((resSubgroup == VK_SUCCESS) ? 5 : 4); i++) {
+			double kernelBandwidth = 2 * 1000 * inputBufferSize / 1024.0 / 1024.0 / 1024.0 / kernelTimings[i]->median;
+			printf("Efficiency of %s: %.1f%% of the best copy, %.2fx the worst strided access\n", kernelNames[i], kernelBandwidth / bandwidth.bestCopy * 100, kernelBandwidth / bandwidth.worstStrided);
+		}
+	}
+	else
+		printf("Bandwidth probes failed, error code: %d\n", resBandwidth);
+	if (timeCPU > 0)
+		printf("CPU baseline (%s kernel, %d threads): %.3f ms, %.2f GB/s, GPU speedup %.1f\n", getCPUKernelName(dataType), getCoreCount(), timeCPU, 2 * 1000 * inputBufferSize / 1024.0 / 1024.0 / 1024.0 / timeCPU, timeCPU / time_no_bank_conflicts.median);
+	printf("In-place transpose bandwidth: %d GB/s (memory footprint: %d KB instead of %d KB)\n", (int)(2 * 1000 * inputBufferSize / 1024.0 / 1024.0 / 1024.0 / time_in_place.median), (int)((inputBufferSize + scratchBufferSize) / 1024), (int)((inputBufferSize + outputBufferSize) / 1024));
+	printf("Coalesced Memory: %d bytes\nSystem size: %dx%d\nBuffer size: %d KB\nBandwidth: %d GB/s\nTranfer time/total transpose time: %0.3f%%\n", app.coalescedMemory, app.size[0], app.size[1], (int)(inputBufferSize / 1024), (int)(2 * 1000 * inputBufferSize / 1024.0 / 1024.0 / 1024.0 / time_bandwidth.median), time_bandwidth.median / time_no_bank_conflicts.median * 100);
 	
 	//free resources
 	free(buffer_output);
-	vkDestroyBuffer(vkGPU.device, inputBuffer, NULL);
-	vkFreeMemory(vkGPU.device, inputBufferDeviceMemory, NULL);
-	vkDestroyBuffer(vkGPU.device, outputBuffer, NULL);
-	vkFreeMemory(vkGPU.device, outputBufferDeviceMemory, NULL);
+	freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+	freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
 	deleteApp(&vkGPU, &app);
 	deleteApp(&vkGPU, &app_bank_conflicts);
 	deleteApp(&vkGPU, &app_bandwidth);
-	vkDestroyFence(vkGPU.device, vkGPU.fence, NULL);
-	vkDestroyCommandPool(vkGPU.device, vkGPU.commandPool, NULL);
-	vkDestroyDevice(vkGPU.device, NULL);
-	DestroyDebugUtilsMessengerEXT(&vkGPU, NULL);
-	vkDestroyInstance(vkGPU.instance, NULL);
-	return res;
-}
-int findFlag(char** argv, int num, char* flag) {
-	//search for the flag in argv
-	for (int i = 0; i < num; i++) {
-		if (strstr(argv[i], flag) != NULL) return i;
+	deleteApp(&vkGPU, &app_subgroup);
+	deleteApp(&vkGPU, &app_in_place);
+	if (inPlaceShaderID == 5) {
+		freeFFTBuffer(&vkGPU, &scratchBuffer, &scratchBufferDeviceMemory);
 	}
-	return 0;
+	deleteGPU(&vkGPU);
+	return res;
 }
-int main(int argc, char* argv[])
+VkResult VulkanInPlaceTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t sizeX, uint32_t sizeY, uint32_t dataType, const char* pipelineCachePath)
 {
-	uint32_t device_id = 0;//device id used in application
-	uint32_t coalescedMemory = 0;//how much memory is coalesced
-	uint32_t size = 2048;
-	
-	//sample CLI
-	if (findFlag(argv, argc, "-h")>0)
-	{
-		//print help
-		printf("Vulkan Compute transposition sample v1.0.0 (31-10-2020). Author: Dmitrii Tolmachev\n");
-		printf("	-h: print help\n");
-		printf("	-devices: print the list of available GPU devices\n");
-		printf("	-d X: select GPU device (default 0)\n");
-		printf("	-c X: specify how much memory is coalesced per transfer: 4-128 bytes (default Nvidia: 32, Intel/AMD: 64, default: 64)\n");
-		printf("	-size X: specify square array size: should be >= coalescedMemory (default 2048)\n");
-		return 0;
-	}
-	if (findFlag(argv, argc, "-devices")>0)
-	{
-		//print device list
-		devices_list();
-		return 0;
+	//in-place transposition allocates only one buffer, so matrices up to the whole device memory can be transposed
+	VkGPU vkGPU = { 0 };
+	vkGPU.device_id = deviceID;
+	vkGPU.pipelineCachePath = pipelineCachePath;
+	VkResult res = VK_SUCCESS;
+	res = createGPU(&vkGPU);
+	if (res != VK_SUCCESS) return res;
+	VkApplication app = { 0 };
+	app.size[0] = sizeX;
+	app.size[1] = sizeY;
+	app.size[2] = 1;
+	app.dataType = dataType;
+	uint32_t elementSize = dataTypes[dataType].size;
+	if (coalescedMemory == 0)
+		app.coalescedMemory = defaultCoalescedMemory(&vkGPU);
+	else
+		app.coalescedMemory = coalescedMemory;
+	//square matrices swap tile pairs, rectangular matrices are permuted with a small scratch buffer
+	uint32_t shaderID = (app.size[0] == app.size[1]) ? 4 : 5;
+	VkDeviceSize bufferSize = (VkDeviceSize)elementSize * app.size[0] * app.size[1] * app.size[2];
+	VkBuffer buffer = { 0 };
+	VkDeviceMemory bufferDeviceMemory = { 0 };
+	res = allocateFFTBuffer(&vkGPU, &buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Buffer allocation failed, error code: %d\n", res);
+		return res;
+	}
+	app.inputBufferSize = bufferSize;
+	app.inputBuffer = &buffer;
+	app.inputBufferDeviceMemory = &bufferDeviceMemory;
+	app.outputBufferSize = bufferSize;
+	app.outputBuffer = &buffer;
+	app.outputBufferDeviceMemory = &bufferDeviceMemory;
+	VkBuffer scratchBuffer = { 0 };
+	VkDeviceMemory scratchBufferDeviceMemory = { 0 };
+	VkDeviceSize scratchBufferSize = 0;
+	if (shaderID == 5) {
+		app.scratchLines = 64;
+		scratchBufferSize = (VkDeviceSize)elementSize * app.scratchLines * ((app.size[0] > app.size[1]) ? app.size[0] : app.size[1]);
+		res = allocateFFTBuffer(&vkGPU, &scratchBuffer, &scratchBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, scratchBufferSize);
+		if (res != VK_SUCCESS) {
+			printf("Scratch buffer allocation failed, error code: %d\n", res);
+			return res;
+		}
+		app.outputBufferSize = scratchBufferSize;
+		app.outputBuffer = &scratchBuffer;
+		app.outputBufferDeviceMemory = &scratchBufferDeviceMemory;
+	}
+	res = createApp(&vkGPU, &app, shaderID);
+	if (res == VK_ERROR_FEATURE_NOT_PRESENT) {
+		printf("Data type %s is not supported by the device\n", dataTypes[dataType].name);
+		freeFFTBuffer(&vkGPU, &buffer, &bufferDeviceMemory);
+		if (shaderID == 5) {
+			freeFFTBuffer(&vkGPU, &scratchBuffer, &scratchBufferDeviceMemory);
+		}
+		deleteApp(&vkGPU, &app);
+		deleteGPU(&vkGPU);
+		return res;
+	}
+	if (res != VK_SUCCESS) {
+		printf("Application creation failed, error code: %d\n", res);
+		return res;
+	}
+	void* buffer_input = malloc(bufferSize);
+	fillInputData(buffer_input, dataType, (uint64_t)app.size[0] * app.size[1] * app.size[2]);
+	transferDataFromCPU(&vkGPU, buffer_input, &buffer, bufferSize);
+	free(buffer_input);
+	VkAppTimings time_in_place = { 0 };
+	res = runApp(&vkGPU, &app, 1000, &time_in_place);
+	if (res != VK_SUCCESS) {
+		printf("Application %d run failed, error code: %d\n", shaderID, res);
+		return res;
+	}
+	printf("Data type: %s (%d bytes)\n", dataTypes[dataType].name, elementSize);
+	printTimings("In-place transpose time", &time_in_place);
+	printf("System size: %dx%d\nBuffer size: %d KB\nScratch buffer size: %d KB\nBandwidth: %d GB/s\n", app.size[0], app.size[1], (int)(bufferSize / 1024), (int)(scratchBufferSize / 1024), (int)(2 * 1000 * bufferSize / 1024.0 / 1024.0 / 1024.0 / time_in_place.median));
+	freeFFTBuffer(&vkGPU, &buffer, &bufferDeviceMemory);
+	if (shaderID == 5) {
+		freeFFTBuffer(&vkGPU, &scratchBuffer, &scratchBufferDeviceMemory);
+	}
+	deleteApp(&vkGPU, &app);
+	deleteGPU(&vkGPU);
+	return res;
+}
+VkResult VulkanPermutationTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t numAxes, uint32_t* shape, uint32_t* permutation, uint32_t dataType, const char* pipelineCachePath)
+{
+	//shape and permutation are passed in the outermost-first order, as in numpy.transpose. The application uses innermost-first order
+	VkGPU vkGPU = { 0 };
+	vkGPU.device_id = deviceID;
+	vkGPU.pipelineCachePath = pipelineCachePath;
+	VkResult res = VK_SUCCESS;
+	res = createGPU(&vkGPU);
+	if (res != VK_SUCCESS) return res;
+	VkApplication app = { 0 };
+	app.numAxes = numAxes;
+	app.dataType = dataType;
+	uint64_t numElements = 1;
+	for (uint32_t i = 0; i < numAxes; i++) {
+		app.axes[i] = shape[numAxes - 1 - i];
+		app.permutation[i] = numAxes - 1 - permutation[numAxes - 1 - i];
+		numElements *= app.axes[i];
+	}
+	app.size[0] = 1;
+	app.size[1] = 1;
+	app.size[2] = 1;
+	if (coalescedMemory == 0)
+		app.coalescedMemory = defaultCoalescedMemory(&vkGPU);
+	else
+		app.coalescedMemory = coalescedMemory;
+	VkDeviceSize bufferSize = dataTypes[dataType].size * numElements;
+	VkBuffer inputBuffer = { 0 };
+	VkDeviceMemory inputBufferDeviceMemory = { 0 };
+	VkBuffer outputBuffer = { 0 };
+	VkDeviceMemory outputBufferDeviceMemory = { 0 };
+	res = allocateFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Input buffer allocation failed, error code: %d\n", res);
+		return res;
+	}
+	res = allocateFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Output buffer allocation failed, error code: %d\n", res);
+		return res;
+	}
+	app.inputBufferSize = bufferSize;
+	app.inputBuffer = &inputBuffer;
+	app.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+	app.outputBufferSize = bufferSize;
+	app.outputBuffer = &outputBuffer;
+	app.outputBufferDeviceMemory = &outputBufferDeviceMemory;
+	//create tensor permutation app
+	res = createApp(&vkGPU, &app, 3);
+	if (res == VK_ERROR_FEATURE_NOT_PRESENT) {
+		printf("Data type %s is not supported by the device\n", dataTypes[dataType].name);
+		freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+		freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+		deleteApp(&vkGPU, &app);
+		deleteGPU(&vkGPU);
+		return res;
+	}
+	if (res != VK_SUCCESS) {
+		printf("Application creation failed, error code: %d\n", res);
+		return res;
+	}
+	void* buffer_input = malloc(bufferSize);
+	fillInputData(buffer_input, dataType, numElements);
+	transferDataFromCPU(&vkGPU, buffer_input, &inputBuffer, bufferSize);
+	free(buffer_input);
+	VkAppTimings time_permutation = { 0 };
+	res = runApp(&vkGPU, &app, 1000, &time_permutation);
+	if (res != VK_SUCCESS) {
+		printf("Application 3 run failed, error code: %d\n", res);
+		return res;
+	}
+	//print results
+	printf("Shape: ");
+	for (uint32_t i = 0; i < numAxes; i++) printf((i < numAxes - 1) ? "%d x " : "%d\n", shape[i]);
+	printf("Permutation: ");
+	for (uint32_t i = 0; i < numAxes; i++) printf((i < numAxes - 1) ? "%d, " : "%d\n", permutation[i]);
+	printf("Data type: %s (%d bytes)\n", dataTypes[dataType].name, dataTypes[dataType].size);
+	printf("Tiled axes extents: %d x %d, remaining index combinations: %d, mode: %s\n", app.specializationConstants.tileExtent[0], app.specializationConstants.tileExtent[1], app.specializationConstants.batchCount, (app.specializationConstants.transposeTile) ? "shared memory transposition" : "strided copy");
+	printTimings("Permutation time", &time_permutation);
+	printf("Buffer size: %d KB\nBandwidth: %d GB/s\n", (int)(bufferSize / 1024), (int)(2 * 1000 * bufferSize / 1024.0 / 1024.0 / 1024.0 / time_permutation.median));
+	freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+	freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+	deleteApp(&vkGPU, &app);
+	deleteGPU(&vkGPU);
+	return res;
+}
+VkResult VulkanStreamTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t sizeX, uint32_t sizeY, uint32_t dataType, uint32_t panelRows, uint32_t numSlots, const char* pipelineCachePath)
+{
+	//out-of-core transposition of a host matrix, that does not have to fit in device memory. Streaming without overlap (one slot) is compared to numSlots panels in flight and to a host memcpy of the matrix
+	VkGPU vkGPU = { 0 };
+	vkGPU.device_id = deviceID;
+	vkGPU.pipelineCachePath = pipelineCachePath;
+	VkResult res = VK_SUCCESS;
+	res = createGPU(&vkGPU);
+	if (res != VK_SUCCESS) return res;
+	uint32_t elementSize = dataTypes[dataType].size;
+	if (((elementSize == 1) && (!vkGPU.storage8Bit)) || ((elementSize == 2) && (!vkGPU.storage16Bit))) {
+		printf("Data type %s is not supported by the device\n", dataTypes[dataType].name);
+		deleteGPU(&vkGPU);
+		return VK_ERROR_FEATURE_NOT_PRESENT;
+	}
+	uint64_t numElements = (uint64_t)sizeX * sizeY;
+	uint64_t matrixSize = elementSize * numElements;
+	void* input = malloc(matrixSize);
+	void* output = malloc(matrixSize);
+	if ((input == NULL) || (output == NULL)) {
+		printf("Host matrix allocation failed, %d MB each\n", (int)(matrixSize / 1024 / 1024));
+		return VK_ERROR_OUT_OF_HOST_MEMORY;
+	}
+	fillInputData(input, dataType, numElements);
+	//host memory bandwidth reference: the stream reads the input and writes the output on the host once each, as a memcpy does
+	double memcpyTime = getWallTime();
+	memcpy(output, input, matrixSize);
+	memcpyTime = getWallTime() - memcpyTime;
+	VkApplication app = { 0 };
+	app.size[0] = sizeX;
+	app.size[1] = sizeY;
+	app.size[2] = 1;
+	app.dataType = dataType;
+	app.coalescedMemory = coalescedMemory;
+	double serialTime = getWallTime();
+	res = streamApp(&vkGPU, &app, input, output, panelRows, 1);
+	if (res != VK_SUCCESS) {
+		printf("Streaming transposition failed, error code: %d\n", res);
+		return res;
+	}
+	serialTime = getWallTime() - serialTime;
+	memset(output, 0, matrixSize);
+	double streamTime = getWallTime();
+	res = streamApp(&vkGPU, &app, input, output, panelRows, numSlots);
+	if (res != VK_SUCCESS) {
+		printf("Streaming transposition failed, error code: %d\n", res);
+		return res;
+	}
+	streamTime = getWallTime() - streamTime;
+	//check a sample of the elements: output element (j, i) is the input element (i, j)
+	uint32_t errors = 0;
+	for (uint64_t n = 0; n < 4096; n++) {
+		uint64_t id = (n * 2654435761u) % numElements;
+		uint64_t i = id % sizeX;
+		uint64_t j = id / sizeX;
+		if (memcmp((char*)output + (i * sizeY + j) * elementSize, (char*)input + id * elementSize, elementSize) != 0) errors++;
+	}
+	printf("Data type: %s (%d bytes), system size: %dx%d, matrix size: %d MB\n", dataTypes[dataType].name, elementSize, sizeX, sizeY, (int)(matrixSize / 1024 / 1024));
+	printf("Streaming without overlap: %.3f ms, %.2f GB/s\n", serialTime, matrixSize / 1024.0 / 1024.0 / 1024.0 / serialTime * 1000);
+	printf("Streaming with %d panels in flight: %.3f ms, %.2f GB/s\n", (numSlots) ? numSlots : 3, streamTime, matrixSize / 1024.0 / 1024.0 / 1024.0 / streamTime * 1000);
+	printf("Host memcpy of the matrix: %.3f ms, %.2f GB/s\n", memcpyTime, matrixSize / 1024.0 / 1024.0 / 1024.0 / memcpyTime * 1000);
+	printf("Sampled elements check: %s\n", (errors) ? "failed" : "passed");
+	free(input);
+	free(output);
+	deleteGPU(&vkGPU);
+	if (errors) return VK_ERROR_INITIALIZATION_FAILED;
+	return res;
+}
+VkResult VulkanZeroCopyTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t sizeX, uint32_t sizeY, uint32_t dataType, const char* pipelineCachePath)
+{
+	//end-to-end latency of the transposition of a host matrix into a host matrix: zero-copy path (imported host memory or host-visible device-local memory) against transfers through the staging ring
+	VkGPU vkGPU = { 0 };
+	vkGPU.device_id = deviceID;
+	vkGPU.pipelineCachePath = pipelineCachePath;
+	VkResult res = VK_SUCCESS;
+	res = createGPU(&vkGPU);
+	if (res != VK_SUCCESS) return res;
+	uint32_t elementSize = dataTypes[dataType].size;
+	if (((elementSize == 1) && (!vkGPU.storage8Bit)) || ((elementSize == 2) && (!vkGPU.storage16Bit))) {
+		printf("Data type %s is not supported by the device\n", dataTypes[dataType].name);
+		deleteGPU(&vkGPU);
+		return VK_ERROR_FEATURE_NOT_PRESENT;
+	}
+	uint64_t numElements = (uint64_t)sizeX * sizeY;
+	VkDeviceSize matrixSize = elementSize * numElements;
+	//host matrices are aligned and padded to the import alignment, so they can be imported
+	uint64_t alignment = (vkGPU.minImportedHostPointerAlignment) ? vkGPU.minImportedHostPointerAlignment : 4096;
+	uint64_t paddedSize = (matrixSize + alignment - 1) / alignment * alignment;
+	char* inputAllocation = (char*)malloc(paddedSize + alignment);
+	char* outputAllocation = (char*)malloc(paddedSize + alignment);
+	char* stagedOutputAllocation = (char*)malloc(paddedSize + alignment);
+	if ((inputAllocation == NULL) || (outputAllocation == NULL) || (stagedOutputAllocation == NULL)) {
+		printf("Host matrix allocation failed, %d MB each\n", (int)(matrixSize / 1024 / 1024));
+		return VK_ERROR_OUT_OF_HOST_MEMORY;
+	}
+	void* input = inputAllocation + (alignment - (uint64_t)(uintptr_t)inputAllocation % alignment) % alignment;
+	void* output = outputAllocation + (alignment - (uint64_t)(uintptr_t)outputAllocation % alignment) % alignment;
+	void* stagedOutput = stagedOutputAllocation + (alignment - (uint64_t)(uintptr_t)stagedOutputAllocation % alignment) % alignment;
+	fillInputData(input, dataType, numElements);
+	//the plan is created once for device buffers, hostApp binds it to the buffers of each path
+	VkBuffer inputBuffer = { 0 };
+	VkDeviceMemory inputBufferDeviceMemory = { 0 };
+	VkBuffer outputBuffer = { 0 };
+	VkDeviceMemory outputBufferDeviceMemory = { 0 };
+	res = allocateFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, matrixSize);
+	if (res != VK_SUCCESS) {
+		printf("Input buffer allocation failed, error code: %d\n", res);
+		return res;
+	}
+	res = allocateFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, matrixSize);
+	if (res != VK_SUCCESS) {
+		printf("Output buffer allocation failed, error code: %d\n", res);
+		return res;
+	}
+	VkApplication app = { 0 };
+	app.size[0] = sizeX;
+	app.size[1] = sizeY;
+	app.size[2] = 1;
+	app.dataType = dataType;
+	app.coalescedMemory = coalescedMemory;
+	app.inputBufferSize = matrixSize;
+	app.inputBuffer = &inputBuffer;
+	app.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+	app.outputBufferSize = matrixSize;
+	app.outputBuffer = &outputBuffer;
+	app.outputBufferDeviceMemory = &outputBufferDeviceMemory;
+	res = createApp(&vkGPU, &app, 0);
+	if (res != VK_SUCCESS) {
+		printf("Application creation failed, error code: %d\n", res);
+		return res;
+	}
+	//one warm-up call per path, then the latency is averaged over 10 calls
+	double latency[2] = { 0 };
+	double minLatency[2] = { 0 };
+	uint32_t hostPath[2] = { 0 };
+	for (uint32_t zeroCopy = 0; zeroCopy < 2; zeroCopy++) {
+		for (uint32_t i = 0; i < 11; i++) {
+			double start = getWallTime();
+			res = hostApp(&vkGPU, &app, input, (zeroCopy) ? output : stagedOutput, zeroCopy, &hostPath[zeroCopy]);
+			if (res != VK_SUCCESS) {
+				printf("Host transposition failed, error code: %d\n", res);
+				return res;
+			}
+			double time = getWallTime() - start;
+			if (i == 0) continue;
+			latency[zeroCopy] += time / 10;
+			if ((i == 1) || (time < minLatency[zeroCopy])) minLatency[zeroCopy] = time;
+		}
+	}
+	//both paths have to produce the same output, and output element (j, i) is the input element (i, j)
+	uint32_t errors = (memcmp(output, stagedOutput, matrixSize) != 0);
+	for (uint64_t n = 0; n < 4096; n++) {
+		uint64_t id = (n * 2654435761u) % numElements;
+		uint64_t i = id % sizeX;
+		uint64_t j = id / sizeX;
+		if (memcmp((char*)output + (i * sizeY + j) * elementSize, (char*)input + id * elementSize, elementSize) != 0) errors++;
+	}
+	const char* hostPathNames[3] = { "staged, no zero-copy support", "imported host memory", "host-visible device-local memory" };
+	printf("Data type: %s (%d bytes), system size: %dx%d, matrix size: %d KB\n", dataTypes[dataType].name, elementSize, sizeX, sizeY, (int)(matrixSize / 1024));
+	printf("VK_EXT_external_memory_host: %s, device type: %s\n", (vkGPU.externalMemoryHost) ? "supported" : "not supported", (vkGPU.physicalDeviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU) ? "integrated" : "not integrated");
+	printf("Staged path latency: %.3f ms (min %.3f ms), %.2f GB/s\n", latency[0], minLatency[0], matrixSize / 1024.0 / 1024.0 / 1024.0 / latency[0] * 1000);
+	printf("Zero-copy path (%s) latency: %.3f ms (min %.3f ms), %.2f GB/s\n", hostPathNames[hostPath[1]], latency[1], minLatency[1], matrixSize / 1024.0 / 1024.0 / 1024.0 / latency[1] * 1000);
+	printf("Output check: %s\n", (errors) ? "failed" : "passed");
+	deleteApp(&vkGPU, &app);
+	freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+	freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+	free(inputAllocation);
+	free(outputAllocation);
+	free(stagedOutputAllocation);
+	deleteGPU(&vkGPU);
+	if (errors) return VK_ERROR_INITIALIZATION_FAILED;
+	return res;
+}
+VkResult VulkanMultiGPUTest(uint32_t numDevices, uint32_t* deviceIDs, uint32_t coalescedMemory, uint32_t sizeX, uint32_t sizeY, uint32_t dataType, const char* pipelineCachePath)
+{
+	//transpose a host matrix split in bands across the first 1, 2, ..., numDevices devices of the list and report the scaling efficiency. A device can be listed several times, each entry gets its own VkGPU
+	VkResult res = VK_SUCCESS;
+	VkGPU* vkGPUs = (VkGPU*)calloc(numDevices, sizeof(VkGPU));
+	double* bandTimes = (double*)calloc(numDevices, sizeof(double));
+	if ((vkGPUs == NULL) || (bandTimes == NULL)) return VK_ERROR_OUT_OF_HOST_MEMORY;
+	uint32_t elementSize = dataTypes[dataType].size;
+	for (uint32_t i = 0; i < numDevices; i++) {
+		vkGPUs[i].device_id = deviceIDs[i];
+		vkGPUs[i].pipelineCachePath = pipelineCachePath;
+		res = createGPU(&vkGPUs[i]);
+		if (res != VK_SUCCESS) {
+			printf("Device %d creation failed, error code: %d\n", deviceIDs[i], res);
+			return res;
+		}
+		if (((elementSize == 1) && (!vkGPUs[i].storage8Bit)) || ((elementSize == 2) && (!vkGPUs[i].storage16Bit))) {
+			printf("Data type %s is not supported by device %d\n", dataTypes[dataType].name, deviceIDs[i]);
+			for (uint32_t j = 0; j <= i; j++)
+				deleteGPU(&vkGPUs[j]);
+			free(vkGPUs);
+			free(bandTimes);
+			return VK_ERROR_FEATURE_NOT_PRESENT;
+		}
+	}
+	uint64_t numElements = (uint64_t)sizeX * sizeY;
+	uint64_t matrixSize = elementSize * numElements;
+	void* input = malloc(matrixSize);
+	void* output = malloc(matrixSize);
+	if ((input == NULL) || (output == NULL)) {
+		printf("Host matrix allocation failed, %d MB each\n", (int)(matrixSize / 1024 / 1024));
+		return VK_ERROR_OUT_OF_HOST_MEMORY;
+	}
+	fillInputData(input, dataType, numElements);
+	VkApplication app = { 0 };
+	app.size[0] = sizeX;
+	app.size[1] = sizeY;
+	app.size[2] = 1;
+	app.dataType = dataType;
+	app.coalescedMemory = coalescedMemory;
+	printf("Data type: %s (%d bytes), system size: %dx%d, matrix size: %d MB\n", dataTypes[dataType].name, elementSize, sizeX, sizeY, (int)(matrixSize / 1024 / 1024));
+	double singleTime = 0;
+	uint32_t errors = 0;
+	for (uint32_t n = 1; n <= numDevices; n++) {
+		//plans and buffers of the bands are created before the timed calls. The first call touches the staging buffers for the first time, the best of 3 calls is reported
+		VkAppMultiPlan multiPlan = { 0 };
+		res = createMultiApp(vkGPUs, n, &app, &multiPlan);
+		if (res != VK_SUCCESS) {
+			printf("Multi-GPU plan creation failed, error code: %d\n", res);
+			return res;
+		}
+		double bestTime = 0;
+		for (uint32_t i = 0; i < 4; i++) {
+			memset(output, 0, matrixSize);
+			double start = getWallTime();
+			res = multiApp(&multiPlan, input, output, bandTimes);
+			if (res != VK_SUCCESS) {
+				printf("Multi-GPU transposition failed, error code: %d\n", res);
+				return res;
+			}
+			double time = getWallTime() - start;
+			if ((i == 1) || ((i > 1) && (time < bestTime))) bestTime = time;
+		}
+		deleteMultiApp(&multiPlan);
+		if (n == 1) singleTime = bestTime;
+		//check a sample of the elements: output element (j, i) is the input element (i, j)
+		for (uint64_t k = 0; k < 4096; k++) {
+			uint64_t id = (k * 2654435761u) % numElements;
+			uint64_t i = id % sizeX;
+			uint64_t j = id / sizeX;
+			if (memcmp((char*)output + (i * sizeY + j) * elementSize, (char*)input + id * elementSize, elementSize) != 0) errors++;
+		}
+		printf("%d device(s): %.3f ms, %.2f GB/s, speedup %.2f, scaling efficiency %.1f%%, band times:", n, bestTime, matrixSize / 1024.0 / 1024.0 / 1024.0 / bestTime * 1000, singleTime / bestTime, singleTime / bestTime / n * 100);
+		for (uint32_t i = 0; i < n; i++)
+			printf(" %.3f", bandTimes[i]);
+		printf(" ms\n");
+	}
+	printf("Sampled elements check: %s\n", (errors) ? "failed" : "passed");
+	free(input);
+	free(output);
+	for (uint32_t i = 0; i < numDevices; i++)
+		deleteGPU(&vkGPUs[i]);
+	free(vkGPUs);
+	free(bandTimes);
+	if (errors) return VK_ERROR_INITIALIZATION_FAILED;
+	return res;
+}
+VkResult VulkanQueuesTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t numJobs, uint32_t sizeX, uint32_t sizeY, uint32_t dataType, const char* pipelineCachePath)
+{
+	//throughput of numJobs independent transposes, each with its own plan and buffers: one after another with executeApp, and submitted through the scheduler to 1, 2, 4, ... and all compute queues
+	VkGPU vkGPU = { 0 };
+	vkGPU.device_id = deviceID;
+	vkGPU.pipelineCachePath = pipelineCachePath;
+	VkResult res = VK_SUCCESS;
+	res = createGPU(&vkGPU);
+	if (res != VK_SUCCESS) return res;
+	uint32_t elementSize = dataTypes[dataType].size;
+	if (((elementSize == 1) && (!vkGPU.storage8Bit)) || ((elementSize == 2) && (!vkGPU.storage16Bit))) {
+		printf("Data type %s is not supported by the device\n", dataTypes[dataType].name);
+		deleteGPU(&vkGPU);
+		return VK_ERROR_FEATURE_NOT_PRESENT;
+	}
+	uint64_t numElements = (uint64_t)sizeX * sizeY;
+	VkDeviceSize bufferSize = elementSize * numElements;
+	void* buffer_input = malloc(bufferSize);
+	void* buffer_output = malloc(bufferSize);
+	VkApplication* apps = (VkApplication*)calloc(numJobs, sizeof(VkApplication));
+	VkBuffer* inputBuffers = (VkBuffer*)calloc(numJobs, sizeof(VkBuffer));
+	VkDeviceMemory* inputBufferDeviceMemory = (VkDeviceMemory*)calloc(numJobs, sizeof(VkDeviceMemory));
+	VkBuffer* outputBuffers = (VkBuffer*)calloc(numJobs, sizeof(VkBuffer));
+	VkDeviceMemory* outputBufferDeviceMemory = (VkDeviceMemory*)calloc(numJobs, sizeof(VkDeviceMemory));
+	if ((buffer_input == NULL) || (buffer_output == NULL) || (apps == NULL) || (inputBuffers == NULL) || (inputBufferDeviceMemory == NULL) || (outputBuffers == NULL) || (outputBufferDeviceMemory == NULL)) return VK_ERROR_OUT_OF_HOST_MEMORY;
+	fillInputData(buffer_input, dataType, numElements);
+	for (uint32_t i = 0; i < numJobs; i++) {
+		res = allocateFFTBuffer(&vkGPU, &inputBuffers[i], &inputBufferDeviceMemory[i], VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+		if (res != VK_SUCCESS) {
+			printf("Input buffer allocation failed, error code: %d\n", res);
+			return res;
+		}
+		res = allocateFFTBuffer(&vkGPU, &outputBuffers[i], &outputBufferDeviceMemory[i], VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+		if (res != VK_SUCCESS) {
+			printf("Output buffer allocation failed, error code: %d\n", res);
+			return res;
+		}
+		res = transferDataFromCPU(&vkGPU, buffer_input, &inputBuffers[i], bufferSize);
+		if (res != VK_SUCCESS) {
+			printf("Upload failed, error code: %d\n", res);
+			return res;
+		}
+		apps[i].size[0] = sizeX;
+		apps[i].size[1] = sizeY;
+		apps[i].size[2] = 1;
+		apps[i].dataType = dataType;
+		apps[i].coalescedMemory = coalescedMemory;
+		apps[i].inputBufferSize = bufferSize;
+		apps[i].inputBuffer = &inputBuffers[i];
+		apps[i].inputBufferDeviceMemory = &inputBufferDeviceMemory[i];
+		apps[i].outputBufferSize = bufferSize;
+		apps[i].outputBuffer = &outputBuffers[i];
+		apps[i].outputBufferDeviceMemory = &outputBufferDeviceMemory[i];
+		res = createApp(&vkGPU, &apps[i], 0);
+		if (res != VK_SUCCESS) {
+			printf("Application creation failed, error code: %d\n", res);
+			return res;
+		}
+	}
+	printf("Data type: %s (%d bytes), system size: %dx%d, %d jobs\n", dataTypes[dataType].name, elementSize, sizeX, sizeY, numJobs);
+	printf("Compute queues: %d\n", vkGPU.numComputeQueues);
+	//every measurement runs all jobs 10 times after one warm-up round
+	double serialTime = 0;
+	for (uint32_t round = 0; round < 11; round++) {
+		double start = getWallTime();
+		for (uint32_t i = 0; i < numJobs; i++) {
+			res = executeApp(&vkGPU, &apps[i]);
+			if (res != VK_SUCCESS) {
+				printf("Application run failed, error code: %d\n", res);
+				return res;
+			}
+		}
+		if (round > 0) serialTime += (getWallTime() - start) / 10;
+	}
+	printf("Serial executeApp: %.3f ms per round, %.0f jobs/s, %.2f GB/s\n", serialTime, numJobs / serialTime * 1000, 2 * numJobs * bufferSize / 1024.0 / 1024.0 / 1024.0 / serialTime * 1000);
+	double singleQueueTime = 0;
+	for (uint32_t numQueues = 1; ; numQueues = (numQueues * 2 < vkGPU.numComputeQueues) ? numQueues * 2 : vkGPU.numComputeQueues) {
+		VkAppScheduler scheduler = { 0 };
+		scheduler.numQueues = numQueues;
+		res = createScheduler(&vkGPU, &scheduler);
+		if (res != VK_SUCCESS) {
+			printf("Scheduler creation failed, error code: %d\n", res);
+			return res;
+		}
+		double scheduledTime = 0;
+		for (uint32_t round = 0; round < 11; round++) {
+			double start = getWallTime();
+			for (uint32_t i = 0; i < numJobs; i++) {
+				uint64_t jobID = 0;
+				res = submitApp(&vkGPU, &scheduler, &apps[i], &jobID);
+				if (res != VK_SUCCESS) {
+					printf("Job submission failed, error code: %d\n", res);
+					return res;
+				}
+			}
+			res = waitScheduler(&vkGPU, &scheduler);
+			if (res != VK_SUCCESS) {
+				printf("Job wait failed, error code: %d\n", res);
+				return res;
+			}
+			if (round > 0) scheduledTime += (getWallTime() - start) / 10;
+		}
+		if (numQueues == 1) singleQueueTime = scheduledTime;
+		printf("Scheduler with %d queue(s): %.3f ms per round, %.0f jobs/s, %.2f GB/s, speedup over one queue %.2f, jobs per queue:", numQueues, scheduledTime, numJobs / scheduledTime * 1000, 2 * numJobs * bufferSize / 1024.0 / 1024.0 / 1024.0 / scheduledTime * 1000, singleQueueTime / scheduledTime);
+		for (uint32_t i = 0; i < numQueues; i++)
+			printf(" %d", (int)scheduler.queues[i].submittedJobs);
+		printf("\n");
+		deleteScheduler(&vkGPU, &scheduler);
+		if (numQueues == vkGPU.numComputeQueues) break;
+	}
+	//check a sample of the elements of the last job: output element (j, i) is the input element (i, j)
+	res = transferDataToCPU(&vkGPU, buffer_output, &outputBuffers[numJobs - 1], bufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Download failed, error code: %d\n", res);
+		return res;
+	}
+	uint32_t errors = 0;
+	for (uint64_t n = 0; n < 4096; n++) {
+		uint64_t id = (n * 2654435761u) % numElements;
+		uint64_t i = id % sizeX;
+		uint64_t j = id / sizeX;
+		if (memcmp((char*)buffer_output + (i * sizeY + j) * elementSize, (char*)buffer_input + id * elementSize, elementSize) != 0) errors++;
+	}
+	printf("Sampled elements check: %s\n", (errors) ? "failed" : "passed");
+	for (uint32_t i = 0; i < numJobs; i++) {
+		deleteApp(&vkGPU, &apps[i]);
+		freeFFTBuffer(&vkGPU, &inputBuffers[i], &inputBufferDeviceMemory[i]);
+		freeFFTBuffer(&vkGPU, &outputBuffers[i], &outputBufferDeviceMemory[i]);
+	}
+	free(apps);
+	free(inputBuffers);
+	free(inputBufferDeviceMemory);
+	free(outputBuffers);
+	free(outputBufferDeviceMemory);
+	free(buffer_input);
+	free(buffer_output);
+	deleteGPU(&vkGPU);
+	if (errors) return VK_ERROR_INITIALIZATION_FAILED;
+	return res;
+}
+VkResult VulkanShapesTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t numShapes, uint32_t dataType, const char* pipelineCachePath)
+{
+	//transpose numShapes distinct shapes with pipelines specialized for each shape, with one dynamic-shape pipeline and through the plan cache
+	VkGPU vkGPU = { 0 };
+	vkGPU.device_id = deviceID;
+	vkGPU.pipelineCachePath = pipelineCachePath;
+	VkResult res = VK_SUCCESS;
+	res = createGPU(&vkGPU);
+	if (res != VK_SUCCESS) return res;
+	uint32_t elementSize = dataTypes[dataType].size;
+	//shapes from 256 to 1279 elements per side, distinct for up to 1024 shapes
+	uint32_t* shapes = (uint32_t*)malloc(2 * numShapes * sizeof(uint32_t));
+	for (uint32_t i = 0; i < numShapes; i++) {
+		shapes[2 * i] = 256 + (37 * i) % 1024;
+		shapes[2 * i + 1] = 256 + (53 * i + 17) % 1024;
+	}
+	//buffers are allocated for the largest shape, all plans work on them
+	VkDeviceSize bufferSize = (VkDeviceSize)elementSize * 1280 * 1280;
+	VkBuffer inputBuffer = { 0 };
+	VkDeviceMemory inputBufferDeviceMemory = { 0 };
+	VkBuffer outputBuffer = { 0 };
+	VkDeviceMemory outputBufferDeviceMemory = { 0 };
+	res = allocateFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Input buffer allocation failed, error code: %d\n", res);
+		return res;
+	}
+	res = allocateFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Output buffer allocation failed, error code: %d\n", res);
+		return res;
+	}
+	VkApplication request = { 0 };
+	request.size[2] = 1;
+	request.dataType = dataType;
+	request.coalescedMemory = coalescedMemory;
+	request.inputBufferSize = bufferSize;
+	request.inputBuffer = &inputBuffer;
+	request.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+	request.outputBufferSize = bufferSize;
+	request.outputBuffer = &outputBuffer;
+	request.outputBufferDeviceMemory = &outputBufferDeviceMemory;
+	//specialized path: a pipeline is compiled for every shape. Kernel time is the median of 10 runs
+	double specializedCreate = 0;
+	double specializedKernel = 0;
+	double dynamicKernel = 0;
+	double movedData = 0;
+	for (uint32_t i = 0; i < numShapes; i++) {
+		VkApplication app = request;
+		app.size[0] = shapes[2 * i];
+		app.size[1] = shapes[2 * i + 1];
+		double createStart = getWallTime();
+		res = createApp(&vkGPU, &app, 0);
+		if (res == VK_ERROR_FEATURE_NOT_PRESENT) {
+			printf("Data type %s is not supported by the device\n", dataTypes[dataType].name);
+			deleteApp(&vkGPU, &app);
+			freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+			freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+			deleteGPU(&vkGPU);
+			return res;
+		}
+		if (res != VK_SUCCESS) {
+			printf("Application creation failed, error code: %d\n", res);
+			return res;
+		}
+		specializedCreate += getWallTime() - createStart;
+		VkAppTimings timings = { 0 };
+		res = runApp(&vkGPU, &app, 10, &timings);
+		deleteApp(&vkGPU, &app);
+		if (res != VK_SUCCESS) {
+			printf("Application 0 run failed, error code: %d\n", res);
+			return res;
+		}
+		specializedKernel += timings.median;
+		movedData += 2.0 * elementSize * shapes[2 * i] * shapes[2 * i + 1];
+	}
+	//dynamic path: one pipeline, the shape is changed with push constants
+	VkApplication dynamicApp = request;
+	dynamicApp.size[0] = shapes[0];
+	dynamicApp.size[1] = shapes[1];
+	dynamicApp.dynamicShape = 1;
+	double dynamicCreate = getWallTime();
+	res = createApp(&vkGPU, &dynamicApp, 0);
+	if (res != VK_SUCCESS) {
+		printf("Application creation failed, error code: %d\n", res);
+		return res;
+	}
+	dynamicCreate = getWallTime() - dynamicCreate;
+	for (uint32_t i = 0; i < numShapes; i++) {
+		dynamicApp.size[0] = shapes[2 * i];
+		dynamicApp.size[1] = shapes[2 * i + 1];
+		res = reshapeApp(&vkGPU, &dynamicApp);
+		if (res != VK_SUCCESS) {
+			printf("Application reshape failed, error code: %d\n", res);
+			return res;
+		}
+		VkAppTimings timings = { 0 };
+		res = runApp(&vkGPU, &dynamicApp, 10, &timings);
+		if (res != VK_SUCCESS) {
+			printf("Application 0 run failed, error code: %d\n", res);
+			return res;
+		}
+		dynamicKernel += timings.median;
+	}
+	deleteApp(&vkGPU, &dynamicApp);
+	//plan cache: every other call goes to one of 4 hot shapes, the rest cycle through all shapes. Hot shapes get specialized plans, cold ones share the dynamic plan
+	VkAppPlanCache cache = { 0 };
+	uint32_t numCalls = 20 * numShapes;
+	double cacheStart = getWallTime();
+	for (uint32_t i = 0; i < numCalls; i++) {
+		uint32_t shapeID = (i % 2) ? (i / 2) % 4 : (i / 2) % numShapes;
+		request.size[0] = shapes[2 * shapeID];
+		request.size[1] = shapes[2 * shapeID + 1];
+		VkApplication* app = NULL;
+		res = getCachedApp(&vkGPU, &cache, &request, 0, &app);
+		if (res != VK_SUCCESS) {
+			printf("Plan cache lookup failed, error code: %d\n", res);
+			return res;
+		}
+		res = executeApp(&vkGPU, app);
+		if (res != VK_SUCCESS) {
+			printf("Application 0 run failed, error code: %d\n", res);
+			return res;
+		}
+	}
+	double cacheTime = (getWallTime() - cacheStart) / numCalls;
+	printf("Data type: %s (%d bytes), %d shapes\n", dataTypes[dataType].name, elementSize, numShapes);
+	printf("Specialized pipelines: %.3f ms creation per shape, %.3f ms average kernel time, %d GB/s\n", specializedCreate / numShapes, specializedKernel / numShapes, (int)(movedData / 1024.0 / 1024.0 / 1024.0 / specializedKernel * 1000));
+	printf("Dynamic-shape pipeline: %.3f ms creation once, %.3f ms average kernel time, %d GB/s\n", dynamicCreate, dynamicKernel / numShapes, (int)(movedData / 1024.0 / 1024.0 / 1024.0 / dynamicKernel * 1000));
+	printf("Dynamic kernel overhead: %.1f%%, compile time is recovered after %.0f calls with one shape\n", (dynamicKernel / specializedKernel - 1) * 100, (dynamicKernel > specializedKernel) ? specializedCreate / (dynamicKernel - specializedKernel) : 0);
+	printf("Plan cache: %d calls, %.3f ms per call, %d hits, %d dynamic and %d specialized plans created (%.3f ms), %d evicted\n", numCalls, cacheTime, (int)cache.hits, (int)cache.dynamicPlans, (int)cache.specializedPlans, cache.createTime, (int)cache.evictions);
+	deletePlanCache(&vkGPU, &cache);
+	free(shapes);
+	freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+	freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+	deleteGPU(&vkGPU);
+	return res;
+}
+//number of mismatching tiles listed for a failed check, per checking thread
+#define VK_APP_VERIFY_REPORTED_TILES 8
+typedef struct {
+	uint32_t matrix;
+	uint32_t tileRow;
+	uint32_t tileColumn;
+	uint32_t errors;
+} VkAppMismatchTile;
+typedef struct {
+	//output of the checked run described as up to VK_APP_MAX_AXES axes, innermost first, with the stride of each axis in the output and in the input (in elements). Axes 0 and 1 are cut in tiles, the other axes are folded in the matrix index
+	uint32_t numAxes;
+	uint32_t extent[VK_APP_MAX_AXES];
+	uint64_t outputStride[VK_APP_MAX_AXES];
+	uint64_t inputStride[VK_APP_MAX_AXES];
+	uint32_t elementSize;
+	uint32_t tileDim;
+	const char* input;
+	const char* output;
+	uint32_t numThreads;
+	//per thread: number of wrong elements, number of listed tiles and the list of VK_APP_VERIFY_REPORTED_TILES tiles
+	uint64_t* errors;
+	uint32_t* numTiles;
+	VkAppMismatchTile* tiles;
+} VkAppVerification;
+typedef struct {
+	const char* name;
+	//0 - out-of-place shaderID with the tile configuration (0 - default) and the dynamic shape flag, 1 - in-place transposition, 2 - CPU transposition
+	uint32_t mode;
+	uint32_t shaderID;
+	uint32_t tileDim;
+	uint32_t blockRows;
+	uint32_t vectorWidth;
+	uint32_t dynamicShape;
+	uint32_t tileOrder;
+} VkAppVerifyVariant;
+void fillVerifyData(void* buffer, uint64_t size) {
+	//pseudo-random bytes in 0x01-0x7e: floating point elements are never NaN or subnormal, so every type is moved bit-exact, and no element matches the 0xff poison of the output buffer
+	for (uint64_t i = 0; i < size; i++)
+		((uint8_t*)buffer)[i] = (uint8_t)((((i + 1) * 2654435761u) >> 16) % 0x7e + 1);
+}
+void verifyThread(void* data, uint32_t id) {
+	//thread id checks every numThreads-th row of tiles over all matrices, element by element against the input element it was moved from
+	VkAppVerification* verification = (VkAppVerification*)data;
+	uint32_t tileDim = verification->tileDim;
+	uint32_t tileRows = (verification->extent[1] + tileDim - 1) / tileDim;
+	uint32_t tileColumns = (verification->extent[0] + tileDim - 1) / tileDim;
+	uint64_t numMatrices = 1;
+	for (uint32_t i = 2; i < verification->numAxes; i++)
+		numMatrices *= verification->extent[i];
+	uint64_t elementSize = verification->elementSize;
+	for (uint64_t task = id; task < numMatrices * tileRows; task += verification->numThreads) {
+		uint64_t matrix = task / tileRows;
+		uint32_t tileRow = (uint32_t)(task % tileRows);
+		uint64_t outputOffset = 0;
+		uint64_t inputOffset = 0;
+		uint64_t matrixIndex = matrix;
+		for (uint32_t i = 2; i < verification->numAxes; i++) {
+			outputOffset += (matrixIndex % verification->extent[i]) * verification->outputStride[i];
+			inputOffset += (matrixIndex % verification->extent[i]) * verification->inputStride[i];
+			matrixIndex /= verification->extent[i];
+		}
+		for (uint32_t tileColumn = 0; tileColumn < tileColumns; tileColumn++) {
+			uint32_t errors = 0;
+			for (uint32_t j = tileRow * tileDim; (j < (tileRow + 1) * tileDim) && (j < verification->extent[1]); j++) {
+				for (uint32_t i = tileColumn * tileDim; (i < (tileColumn + 1) * tileDim) && (i < verification->extent[0]); i++) {
+					uint64_t outputIndex = outputOffset + i * verification->outputStride[0] + j * verification->outputStride[1];
+					uint64_t inputIndex = inputOffset + i * verification->inputStride[0] + j * verification->inputStride[1];
+					if (memcmp(verification->output + outputIndex * elementSize, verification->input + inputIndex * elementSize, elementSize) != 0) errors++;
+				}
+			}
+			if (errors == 0) continue;
+			verification->errors[id] += errors;
+			if (verification->numTiles[id] < VK_APP_VERIFY_REPORTED_TILES) {
+				VkAppMismatchTile* tile = &verification->tiles[id * VK_APP_VERIFY_REPORTED_TILES + verification->numTiles[id]];
+				tile->matrix = (uint32_t)matrix;
+				tile->tileRow = tileRow;
+				tile->tileColumn = tileColumn;
+				tile->errors = errors;
+				verification->numTiles[id]++;
+			}
+		}
+	}
+}
+uint64_t verifyOutput(VkAppVerification* verification, const char* name) {
+	//check the output on all cores and print the mismatching tiles. Returns the number of wrong elements
+	uint32_t numThreads = getCoreCount();
+	verification->numThreads = numThreads;
+	verification->errors = (uint64_t*)calloc(numThreads, sizeof(uint64_t));
+	verification->numTiles = (uint32_t*)calloc(numThreads, sizeof(uint32_t));
+	verification->tiles = (VkAppMismatchTile*)calloc((uint64_t)numThreads * VK_APP_VERIFY_REPORTED_TILES, sizeof(VkAppMismatchTile));
+	uint64_t errors = 0;
+	if ((verification->errors == NULL) || (verification->numTiles == NULL) || (verification->tiles == NULL) || (runThreads(numThreads, verifyThread, verification) != VK_SUCCESS)) {
+		printf("%s: could not run the check\n", name);
+		errors = 1;
+	}
+	else {
+		uint32_t reported = 0;
+		for (uint32_t i = 0; i < numThreads; i++)
+			errors += verification->errors[i];
+		if (errors)
+			printf("%s: FAILED, %llu wrong elements, output tiles of %dx%d elements:\n", name, (unsigned long long)errors, verification->tileDim, verification->tileDim);
+		for (uint32_t i = 0; i < numThreads; i++) {
+			for (uint32_t j = 0; (j < verification->numTiles[i]) && (reported < VK_APP_VERIFY_REPORTED_TILES); j++, reported++) {
+				VkAppMismatchTile* tile = &verification->tiles[i * VK_APP_VERIFY_REPORTED_TILES + j];
+				printf("	matrix %d, tile row %d, tile column %d (rows %d-%d, columns %d-%d): %d wrong elements\n", tile->matrix, tile->tileRow, tile->tileColumn, tile->tileRow * verification->tileDim, ((tile->tileRow + 1) * verification->tileDim < verification->extent[1]) ? (tile->tileRow + 1) * verification->tileDim - 1 : verification->extent[1] - 1, tile->tileColumn * verification->tileDim, ((tile->tileColumn + 1) * verification->tileDim < verification->extent[0]) ? (tile->tileColumn + 1) * verification->tileDim - 1 : verification->extent[0] - 1, tile->errors);
+			}
+		}
+	}
+	free(verification->errors);
+	free(verification->numTiles);
+	free(verification->tiles);
+	return errors;
+}
+void setVerification2D(VkAppVerification* verification, VkApplication* app, uint32_t transposed) {
+	//output of a 2D app: transposed - output row i is input column i, otherwise (transfer shader) the output has the shape of the input. Both use the output strides requested by the app
+	uint32_t inputStride[3];
+	uint32_t outputStride[3];
+	getAppStrides(app, inputStride, outputStride);
+	verification->numAxes = 3;
+	verification->elementSize = dataTypes[app->dataType].size;
+	verification->extent[0] = (transposed) ? app->size[1] : app->size[0];
+	verification->extent[1] = (transposed) ? app->size[0] : app->size[1];
+	verification->extent[2] = app->size[2];
+	verification->inputStride[0] = (transposed) ? inputStride[1] : 1;
+	verification->inputStride[1] = (transposed) ? 1 : inputStride[1];
+	verification->inputStride[2] = inputStride[2];
+	verification->outputStride[0] = 1;
+	verification->outputStride[1] = outputStride[1];
+	verification->outputStride[2] = outputStride[2];
+	verification->tileDim = (app->tileDim) ? app->tileDim : 32;
+}
+VkResult VulkanVerifyTest(uint32_t deviceID, uint32_t coalescedMemory, uint32_t sizeX, uint32_t sizeY, uint32_t dataType, const char* pipelineCachePath)
+{
+	//run every kernel variant once on a set of shapes, including edge cases, and check the results against the input on the host. Needs no timestamps or optional features besides 8- and 16-bit storage for those types, so software implementations can run it
+	VkGPU vkGPU = { 0 };
+	vkGPU.device_id = deviceID;
+	vkGPU.pipelineCachePath = pipelineCachePath;
+	VkResult res = VK_SUCCESS;
+	res = createGPU(&vkGPU);
+	if (res != VK_SUCCESS) return res;
+	uint32_t elementSize = dataTypes[dataType].size;
+	if (((elementSize == 1) && (!vkGPU.storage8Bit)) || ((elementSize == 2) && (!vkGPU.storage16Bit))) {
+		printf("Data type %s is not supported by the device\n", dataTypes[dataType].name);
+		deleteGPU(&vkGPU);
+		return VK_ERROR_FEATURE_NOT_PRESENT;
+	}
+	if (coalescedMemory == 0) coalescedMemory = defaultCoalescedMemory(&vkGPU);
+	printf("Verification on %s%s, data type: %s (%d bytes)\n", vkGPU.physicalDeviceProperties.deviceName, (vkGPU.physicalDeviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) ? " (software implementation)" : "", dataTypes[dataType].name, elementSize);
+	//2D shapes: the selected one, degenerate and odd sizes, sizes that are multiples of the tiles and a batch. The last entry also has padded rows in the input and the output
+	const uint32_t shapes[][3] = { { sizeX, sizeY, 1 }, { 1, 1, 1 }, { 1, 37, 1 }, { 37, 1, 1 }, { 31, 31, 1 }, { 64, 64, 1 }, { 100, 37, 1 }, { 257, 129, 1 }, { 33, 65, 3 }, { 65, 33, 2 } };
+	const uint32_t numShapes = sizeof(shapes) / sizeof(shapes[0]);
+	//2D variants, see VkAppVerifyVariant
+	const VkAppVerifyVariant variants[] = {
+		{ "padded shared memory", 0, 0, 0, 0, 0, 0, 0 },
+		{ "padded shared memory, tile 8, rows 2", 0, 0, 8, 2, 1, 0, 0 },
+		{ "padded shared memory, tile 32, rows 8, vector 2", 0, 0, 32, 8, 2, 0, 0 },
+		{ "padded shared memory, tile 64, rows 16, vector 4", 0, 0, 64, 16, 4, 0, 0 },
+		{ "padded shared memory, dynamic shape", 0, 0, 0, 0, 0, 1, 0 },
+		{ "padded shared memory, tile 8, rows 2, diagonal order", 0, 0, 8, 2, 1, 0, VK_APP_TILE_ORDER_DIAGONAL },
+		{ "padded shared memory, tile 8, rows 2, swizzled order", 0, 0, 8, 2, 1, 0, VK_APP_TILE_ORDER_SWIZZLED },
+		{ "padded shared memory, diagonal order, dynamic shape", 0, 0, 0, 0, 0, 1, VK_APP_TILE_ORDER_DIAGONAL },
+		{ "unpadded shared memory", 0, 1, 0, 0, 0, 0, 0 },
+		{ "unpadded shared memory, tile 16, rows 4, vector 4", 0, 1, 16, 4, 4, 0, 0 },
+		{ "unpadded shared memory, swizzled order", 0, 1, 0, 0, 0, 0, VK_APP_TILE_ORDER_SWIZZLED },
+		{ "transfer", 0, 2, 0, 0, 0, 0, 0 },
+		{ "transfer, dynamic shape", 0, 2, 0, 0, 0, 1, 0 },
+		{ "subgroup shuffles", 0, 7, 0, 0, 0, 0, 0 },
+		{ "in-place", 1, 0, 0, 0, 0, 0, 0 },
+		{ "CPU", 2, 0, 0, 0, 0, 0, 0 },
+	};
+	const uint32_t numVariants = sizeof(variants) / sizeof(variants[0]);
+	//tensor permutations, shapes and permutations in the innermost-first order of VkApplication
+	const uint32_t permutationShapes[][4] = { { 5, 17, 33, 1 }, { 3, 4, 5, 6 } };
+	const uint32_t permutationAxes[] = { 3, 4 };
+	const uint32_t permutations[][4] = { { 0, 1, 2, 0 }, { 1, 0, 2, 0 }, { 0, 2, 1, 0 }, { 2, 1, 0, 0 }, { 1, 2, 0, 0 }, { 2, 0, 1, 0 }, { 3, 2, 1, 0 }, { 0, 2, 3, 1 }, { 1, 0, 3, 2 } };
+	const uint32_t permutationShape[] = { 0, 0, 0, 0, 0, 0, 1, 1, 1 };
+	uint32_t numChecks = 0;
+	uint32_t failedChecks = 0;
+	for (uint32_t s = 0; s < numShapes + sizeof(permutations) / sizeof(permutations[0]); s++) {
+		uint32_t permutation = (s >= numShapes);
+		uint32_t strided = (s == numShapes - 1);
+		VkApplication app_shape = { 0 };
+		app_shape.dataType = dataType;
+		app_shape.coalescedMemory = coalescedMemory;
+		char shapeName[64];
+		if (permutation) {
+			uint32_t p = s - numShapes;
+			app_shape.numAxes = permutationAxes[permutationShape[p]];
+			app_shape.size[0] = 1;
+			app_shape.size[1] = 1;
+			app_shape.size[2] = 1;
+			for (uint32_t i = 0; i < app_shape.numAxes; i++) {
+				app_shape.axes[i] = permutationShapes[permutationShape[p]][i];
+				app_shape.permutation[i] = permutations[p][i];
+			}
+			if (app_shape.numAxes == 3)
+				snprintf(shapeName, sizeof(shapeName), "%dx%dx%d permuted to %d,%d,%d", app_shape.axes[0], app_shape.axes[1], app_shape.axes[2], app_shape.permutation[0], app_shape.permutation[1], app_shape.permutation[2]);
+			else
+				snprintf(shapeName, sizeof(shapeName), "%dx%dx%dx%d permuted to %d,%d,%d,%d", app_shape.axes[0], app_shape.axes[1], app_shape.axes[2], app_shape.axes[3], app_shape.permutation[0], app_shape.permutation[1], app_shape.permutation[2], app_shape.permutation[3]);
+		}
+		else {
+			app_shape.size[0] = shapes[s][0];
+			app_shape.size[1] = shapes[s][1];
+			app_shape.size[2] = shapes[s][2];
+			if (strided) {
+				app_shape.inputRowStride = shapes[s][0] + 3;
+				//the output rows are padded for both the transposed and the copied layout
+				app_shape.outputRowStride = ((shapes[s][0] > shapes[s][1]) ? shapes[s][0] : shapes[s][1]) + 5;
+			}
+			snprintf(shapeName, sizeof(shapeName), "%dx%dx%d%s", app_shape.size[0], app_shape.size[1], app_shape.size[2], (strided) ? " with padded rows" : "");
+		}
+		//buffer sizes: the input with its strides, the larger of the output and the scratch buffer of the rectangular in-place transposition
+		uint64_t numInputElements = 1;
+		uint64_t numOutputElements = 1;
+		if (permutation) {
+			for (uint32_t i = 0; i < app_shape.numAxes; i++)
+				numInputElements *= app_shape.axes[i];
+			numOutputElements = numInputElements;
+		}
+		else {
+			uint32_t inputStride[3];
+			uint32_t outputStride[3];
+			getAppStrides(&app_shape, inputStride, outputStride);
+			numInputElements = (uint64_t)inputStride[2] * app_shape.size[2];
+			numOutputElements = (uint64_t)outputStride[2] * app_shape.size[2];
+			uint64_t scratchElements = 64 * (uint64_t)((app_shape.size[0] > app_shape.size[1]) ? app_shape.size[0] : app_shape.size[1]);
+			if (scratchElements > numOutputElements) numOutputElements = scratchElements;
+			if (numInputElements > numOutputElements) numOutputElements = numInputElements;
+		}
+		VkDeviceSize inputBufferSize = elementSize * numInputElements;
+		VkDeviceSize outputBufferSize = elementSize * numOutputElements;
+		VkBuffer inputBuffer = { 0 };
+		VkDeviceMemory inputBufferDeviceMemory = { 0 };
+		VkBuffer outputBuffer = { 0 };
+		VkDeviceMemory outputBufferDeviceMemory = { 0 };
+		res = allocateFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, inputBufferSize);
+		if (res != VK_SUCCESS) {
+			printf("Input buffer allocation failed, error code: %d\n", res);
+			return res;
+		}
+		res = allocateFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, outputBufferSize);
+		if (res != VK_SUCCESS) {
+			printf("Output buffer allocation failed, error code: %d\n", res);
+			return res;
+		}
+		void* buffer_input = malloc(inputBufferSize);
+		void* buffer_output = malloc(outputBufferSize);
+		void* buffer_poison = malloc(outputBufferSize);
+		if ((buffer_input == NULL) || (buffer_output == NULL) || (buffer_poison == NULL)) {
+			printf("Host buffer allocation failed\n");
+			return VK_ERROR_OUT_OF_HOST_MEMORY;
+		}
+		fillVerifyData(buffer_input, inputBufferSize);
+		memset(buffer_poison, 0xff, outputBufferSize);
+		uint32_t shapeChecks = 0;
+		uint32_t shapeFailures = 0;
+		for (uint32_t v = 0; v < ((permutation) ? 1 : numVariants); v++) {
+			char name[256];
+			VkApplication app = app_shape;
+			VkAppVerification verification = { 0 };
+			verification.input = (const char*)buffer_input;
+			verification.output = (const char*)buffer_output;
+			//elements the kernel does not write keep the 0xff poison, so they are never mistaken for correct ones
+			res = transferDataFromCPU(&vkGPU, buffer_input, &inputBuffer, inputBufferSize);
+			if (res == VK_SUCCESS) res = transferDataFromCPU(&vkGPU, buffer_poison, &outputBuffer, outputBufferSize);
+			if (res != VK_SUCCESS) {
+				printf("Upload failed, error code: %d\n", res);
+				return res;
+			}
+			if (permutation) {
+				//output axis i is the input axis permutation[i], both arrays are packed
+				uint64_t inputStride[VK_APP_MAX_AXES];
+				uint64_t stride = 1;
+				for (uint32_t i = 0; i < app.numAxes; i++) {
+					inputStride[i] = stride;
+					stride *= app.axes[i];
+				}
+				stride = 1;
+				verification.numAxes = app.numAxes;
+				verification.elementSize = elementSize;
+				verification.tileDim = 32;
+				for (uint32_t i = 0; i < app.numAxes; i++) {
+					verification.extent[i] = app.axes[app.permutation[i]];
+					verification.inputStride[i] = inputStride[app.permutation[i]];
+					verification.outputStride[i] = stride;
+					stride *= verification.extent[i];
+				}
+				snprintf(name, sizeof(name), "%s %s, permutation", dataTypes[dataType].name, shapeName);
+				app.inputBufferSize = inputBufferSize;
+				app.inputBuffer = &inputBuffer;
+				app.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+				app.outputBufferSize = outputBufferSize;
+				app.outputBuffer = &outputBuffer;
+				app.outputBufferDeviceMemory = &outputBufferDeviceMemory;
+				res = createApp(&vkGPU, &app, 3);
+			}
+			else if (variants[v].mode == 2) {
+				//CPU transposition writes the host output directly
+				snprintf(name, sizeof(name), "%s %s, %s (%s)", dataTypes[dataType].name, shapeName, variants[v].name, getCPUKernelName(dataType));
+				setVerification2D(&verification, &app, 1);
+				memset(buffer_output, 0xff, outputBufferSize);
+				res = cpuApp(&app, buffer_input, buffer_output, 0);
+				if (res != VK_SUCCESS) {
+					printf("CPU transposition failed, error code: %d\n", res);
+					return res;
+				}
+				shapeChecks++;
+				if (verifyOutput(&verification, name)) shapeFailures++;
+				continue;
+			}
+			else if (variants[v].mode == 1) {
+				//in-place transposition needs packed data, square matrices swap tile pairs, rectangular ones use the output buffer as scratch and only one matrix
+				uint32_t shaderID = (app.size[0] == app.size[1]) ? 4 : 5;
+				if (strided || ((shaderID == 5) && (app.size[2] != 1))) continue;
+				snprintf(name, sizeof(name), "%s %s, %s", dataTypes[dataType].name, shapeName, (shaderID == 4) ? "in-place" : "in-place rectangular");
+				setVerification2D(&verification, &app, 1);
+				verification.output = (const char*)buffer_output;
+				app.inputBufferSize = inputBufferSize;
+				app.inputBuffer = &inputBuffer;
+				app.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+				app.outputBufferSize = (shaderID == 4) ? inputBufferSize : outputBufferSize;
+				app.outputBuffer = (shaderID == 4) ? &inputBuffer : &outputBuffer;
+				app.outputBufferDeviceMemory = (shaderID == 4) ? &inputBufferDeviceMemory : &outputBufferDeviceMemory;
+				app.scratchLines = (shaderID == 5) ? 64 : 0;
+				res = createApp(&vkGPU, &app, shaderID);
+			}
+			else {
+				app.tileDim = variants[v].tileDim;
+				app.blockRows = variants[v].blockRows;
+				app.vectorWidth = variants[v].vectorWidth;
+				app.dynamicShape = variants[v].dynamicShape;
+				app.tileOrder = variants[v].tileOrder;
+				app.inputBufferSize = inputBufferSize;
+				app.inputBuffer = &inputBuffer;
+				app.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+				app.outputBufferSize = outputBufferSize;
+				app.outputBuffer = &outputBuffer;
+				app.outputBufferDeviceMemory = &outputBufferDeviceMemory;
+				res = createApp(&vkGPU, &app, variants[v].shaderID);
+				//devices without subgroup shuffles in compute shaders skip the subgroup variant
+				if ((res == VK_ERROR_FEATURE_NOT_PRESENT) && (variants[v].shaderID == 7)) {
+					deleteApp(&vkGPU, &app);
+					res = VK_SUCCESS;
+					continue;
+				}
+				//the name lists the configuration used, createApp adjusts the requested one to the device limits and the data type
+				setVerification2D(&verification, &app, (variants[v].shaderID != 2));
+				snprintf(name, sizeof(name), "%s %s, %s (tile %d, rows %d, vector %d)", dataTypes[dataType].name, shapeName, variants[v].name, app.tileDim, app.blockRows, app.vectorWidth);
+			}
+			if (res != VK_SUCCESS) {
+				printf("%s: application creation failed, error code: %d\n", name, res);
+				deleteApp(&vkGPU, &app);
+				shapeChecks++;
+				shapeFailures++;
+				continue;
+			}
+			res = executeApp(&vkGPU, &app);
+			if (res != VK_SUCCESS) {
+				printf("%s: run failed, error code: %d\n", name, res);
+				return res;
+			}
+			//in-place results are read back from the input buffer and checked against the host copy of the input
+			if ((!permutation) && (variants[v].mode == 1))
+				res = transferDataToCPU(&vkGPU, buffer_output, &inputBuffer, inputBufferSize);
+			else
+				res = transferDataToCPU(&vkGPU, buffer_output, &outputBuffer, outputBufferSize);
+			if (res != VK_SUCCESS) {
+				printf("Download failed, error code: %d\n", res);
+				return res;
+			}
+			deleteApp(&vkGPU, &app);
+			shapeChecks++;
+			if (verifyOutput(&verification, name)) shapeFailures++;
+		}
+		printf("%s %s: %d of %d checks passed\n", dataTypes[dataType].name, shapeName, shapeChecks - shapeFailures, shapeChecks);
+		numChecks += shapeChecks;
+		failedChecks += shapeFailures;
+		free(buffer_input);
+		free(buffer_output);
+		free(buffer_poison);
+		freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+		freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+	}
+	printf("Verification of %s: %s, %d of %d checks passed\n", dataTypes[dataType].name, (failedChecks) ? "FAILED" : "passed", numChecks - failedChecks, numChecks);
+	deleteGPU(&vkGPU);
+	if (failedChecks) return VK_ERROR_INITIALIZATION_FAILED;
+	return res;
+}
+VkResult VulkanAutotune(uint32_t deviceID, uint32_t sizeX, uint32_t sizeY, uint32_t dataType, const char* tuningPath, const char* pipelineCachePath)
+{
+	//sweep tile edge, number of thread rows, vector width and padded or unpadded shared memory for the given shape and data type. The fastest configuration is saved to the tuning database
+	VkGPU vkGPU = { 0 };
+	vkGPU.device_id = deviceID;
+	vkGPU.pipelineCachePath = pipelineCachePath;
+	VkResult res = VK_SUCCESS;
+	res = createGPU(&vkGPU);
+	if (res != VK_SUCCESS) return res;
+	uint32_t elementSize = dataTypes[dataType].size;
+	VkDeviceSize bufferSize = (VkDeviceSize)elementSize * sizeX * sizeY;
+	VkBuffer inputBuffer = { 0 };
+	VkDeviceMemory inputBufferDeviceMemory = { 0 };
+	VkBuffer outputBuffer = { 0 };
+	VkDeviceMemory outputBufferDeviceMemory = { 0 };
+	res = allocateFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Input buffer allocation failed, error code: %d\n", res);
+		return res;
+	}
+	res = allocateFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+	if (res != VK_SUCCESS) {
+		printf("Output buffer allocation failed, error code: %d\n", res);
+		return res;
+	}
+	const uint32_t tileDims[] = { 8, 16, 32, 64, 128 };
+	const uint32_t blockRowsList[] = { 1, 2, 4, 8, 16, 32 };
+	const uint32_t vectorWidths[] = { 1, 2, 4 };
+	VkAppTuningRecord best = { 0 };
+	best.vendorID = vkGPU.physicalDeviceProperties.vendorID;
+	best.deviceID = vkGPU.physicalDeviceProperties.deviceID;
+	best.driverVersion = vkGPU.physicalDeviceProperties.driverVersion;
+	best.dataType = dataType;
+	best.size[0] = sizeX;
+	best.size[1] = sizeY;
+	best.time = -1;
+	printf("Data type: %s (%d bytes), system size: %dx%d\n", dataTypes[dataType].name, elementSize, sizeX, sizeY);
+	for (uint32_t shaderID = 0; shaderID < 2; shaderID++) {
+		for (uint32_t t = 0; t < sizeof(tileDims) / sizeof(uint32_t); t++) {
+			for (uint32_t r = 0; r < sizeof(blockRowsList) / sizeof(uint32_t); r++) {
+				for (uint32_t v = 0; v < sizeof(vectorWidths) / sizeof(uint32_t); v++) {
+					if (blockRowsList[r] > tileDims[t]) continue;
+					VkApplication app = { 0 };
+					app.size[0] = sizeX;
+					app.size[1] = sizeY;
+					app.size[2] = 1;
+					app.dataType = dataType;
+					app.tileDim = tileDims[t];
+					app.blockRows = blockRowsList[r];
+					app.vectorWidth = vectorWidths[v];
+					app.inputBufferSize = bufferSize;
+					app.inputBuffer = &inputBuffer;
+					app.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+					app.outputBufferSize = bufferSize;
+					app.outputBuffer = &outputBuffer;
+					app.outputBufferDeviceMemory = &outputBufferDeviceMemory;
+					res = createApp(&vkGPU, &app, shaderID);
+					if (res == VK_ERROR_FEATURE_NOT_PRESENT) {
+						printf("Data type %s is not supported by the device\n", dataTypes[dataType].name);
+						deleteApp(&vkGPU, &app);
+						freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+						freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+						deleteGPU(&vkGPU);
+						return res;
+					}
+					//configurations that exceed device limits or were adjusted by createApp are skipped, they are covered by other candidates
+					if ((res != VK_SUCCESS) || (app.tileDim != tileDims[t]) || (app.blockRows != blockRowsList[r]) || (app.vectorWidth != vectorWidths[v])) {
+						deleteApp(&vkGPU, &app);
+						continue;
+					}
+					//discarded warm-up run, so the first candidate does not pay for cold caches and clocks
+					res = executeApp(&vkGPU, &app);
+					VkAppTimings timings = { 0 };
+					if (res == VK_SUCCESS) res = runApp(&vkGPU, &app, 100, &timings);
+					deleteApp(&vkGPU, &app);
+					if (res != VK_SUCCESS) {
+						printf("Application %d run failed, error code: %d\n", shaderID, res);
+						return res;
+					}
+					printf("%s shared memory, tile: %d, rows: %d, vector width: %d - %.3f ms, %d GB/s\n", (shaderID == 0) ? "padded" : "unpadded", tileDims[t], blockRowsList[r], vectorWidths[v], timings.median, (int)(2 * 1000 * bufferSize / 1024.0 / 1024.0 / 1024.0 / timings.median));
+					if ((best.time < 0) || (timings.median < best.time)) {
+						best.shaderID = shaderID;
+						best.tileDim = tileDims[t];
+						best.blockRows = blockRowsList[r];
+						best.vectorWidth = vectorWidths[v];
+						best.time = timings.median;
+					}
+				}
+			}
+		}
+	}
+	freeFFTBuffer(&vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+	freeFFTBuffer(&vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+	deleteGPU(&vkGPU);
+	if (best.time < 0) {
+		printf("No configuration could be created on this device\n");
+		return VK_ERROR_INITIALIZATION_FAILED;
+	}
+	printf("Best configuration: %s shared memory, tile: %d, rows: %d, vector width: %d - %.3f ms, %d GB/s\n", (best.shaderID == 0) ? "padded" : "unpadded", best.tileDim, best.blockRows, best.vectorWidth, best.time, (int)(2 * 1000 * bufferSize / 1024.0 / 1024.0 / 1024.0 / best.time));
+	res = saveTuningRecord(tuningPath, &best);
+	if (res != VK_SUCCESS) {
+		printf("Could not write tuning database: %s\n", tuningPath);
+		return res;
+	}
+	printf("Saved to %s\n", tuningPath);
+	return res;
+}
+uint32_t parseList(char* value, uint32_t* list, uint32_t maxCount) {
+	//parse comma-separated list of unsigned 32-bit integers, returns the number of parsed values. Lists with signs, other characters, values above 4294967295 or more than maxCount entries are rejected with 0
+	uint32_t count = 0;
+	char* position = value;
+	while (1) {
+		if ((count == maxCount) || (position[0] < '0') || (position[0] > '9')) return 0;
+		char* end = NULL;
+		unsigned long long entry = strtoull(position, &end, 10);
+		if (entry > 0xffffffffull) return 0;
+		list[count] = (uint32_t)entry;
+		count++;
+		if (end[0] == '\0') break;
+		if (end[0] != ',') return 0;
+		position = end + 1;
+	}
+	return count;
+}
+int findFlag(char** argv, int num, char* flag) {
+	//search for the flag in argv. Flags are matched exactly, so -size is not found in -sizeX
+	for (int i = 0; i < num; i++) {
+		if (strcmp(argv[i], flag) == 0) return i;
+	}
+	return 0;
+}
+int main(int argc, char* argv[])
+{
+	uint32_t device_id = 0;//device id used in application
+	uint32_t coalescedMemory = 0;//how much memory is coalesced
+	uint32_t sizeX = 2048;//number of columns, contiguous dimension
+	uint32_t sizeY = 2048;//number of rows
+	uint32_t inPlace = 0;//only run in-place transposition
+	uint32_t numAxes = 0;//number of axes in the tensor permutation
+	uint32_t shape[VK_APP_MAX_AXES];
+	uint32_t permutation[VK_APP_MAX_AXES];
+	uint32_t dataType = 0;//element type, index in dataTypes
+	uint32_t allDataTypes = 0;//run the test for every element type
+	uint32_t tileDim = 0;//tile edge of the 2D shaders, 0 - default
+	uint32_t blockRows = 0;//number of thread rows of the 2D shaders, 0 - default
+	uint32_t vectorWidth = 0;//vector width of the 2D shaders, 0 - default
+	uint32_t tileOrder = VK_APP_TILE_ORDER_LINEAR;//workgroup to tile mapping of the 2D transposition
+	uint32_t autotune = 0;//sweep tile configurations and save the fastest one
+	uint32_t numShapes = 0;//number of distinct shapes in the specialized and dynamic-shape benchmark
+	uint32_t stream = 0;//out-of-core streaming transposition of a host matrix
+	uint32_t panelRows = 0;//rows per streamed panel, 0 - about 32 MB per panel
+	uint32_t numSlots = 0;//streamed panels in flight, 0 - default 3
+	uint32_t numMultiDevices = 0;//number of devices in the multi-GPU split
+	uint32_t multiDevices[16];//devices of the multi-GPU split, a device can be listed several times
+	uint32_t numJobs = 0;//number of independent transposes in the multi-queue benchmark
+	uint32_t zeroCopy = 0;//latency of the zero-copy and staged transposition of a host matrix
+	uint32_t cpu = 0;//transposition on the CPU with 1 to all cores
+	uint32_t verify = 0;//check every kernel variant against the host reference
+	char* tuningPath = "VulkanTransposition.tuning";//tuning database
+	char* pipelineCachePath = "VulkanTransposition.pipelinecache";//pipeline cache file, NULL - no file
+	
+	//sample CLI
+	if (findFlag(argv, argc, "-h")>0)
+	{
+		//print help
+		printf("Vulkan Compute transposition sample v1.0.0 (31-10-2020). Author: Dmitrii Tolmachev\n");
+		printf("	-h: print help\n");
+		printf("	-devices: print the list of available GPU devices\n");
+		printf("	-d X: select GPU device (default 0)\n");
+		printf("	-c X: specify how much memory is coalesced per transfer: 4-128 bytes (default Nvidia: 32, Intel/AMD: 64, default: 64)\n");
+		printf("	-size X: specify square array size (default 2048)\n");
+		printf("	-sizeX X: specify the number of columns of the array, overrides -size (default 2048)\n");
+		printf("	-sizeY X: specify the number of rows of the array, overrides -size (default 2048)\n");
+		printf("	-inplace: only run in-place transposition, without allocating the output buffer\n");
+		printf("	-shape X,Y,...: run tensor permutation of a tensor with up to %d axes, listed outermost first (NCHW tensor: N,C,H,W)\n", VK_APP_MAX_AXES);
+		printf("	-permutation X,Y,...: output axis i is the input axis X_i, as in numpy.transpose (NCHW to NHWC: 0,2,3,1, default: reversed axes)\n");
+		printf("	-dtype X: element type: fp32, fp16, fp64, int8, complex_fp32, complex_fp64 or all (default fp32)\n");
+		printf("	-tile X: tile edge of the transposition and transfer shaders in elements (default: coalesced memory size, at least 32)\n");
+		printf("	-rows X: number of thread rows in the workgroup, each thread moves tile / X rows (default 8)\n");
+		printf("	-vec X: number of consecutive elements moved by a thread as one vector: 1, 2 or 4, fp32 only (default 1)\n");
+		printf("	-order X: order in which the workgroups visit the tiles: linear, diagonal or swizzled (default linear)\n");
+		printf("	-stream: out-of-core transposition of a host matrix, streamed through the GPU in row panels. The matrix does not have to fit in device memory\n");
+		printf("	-panel X: number of rows in a streamed panel (default: about 32 MB per panel)\n");
+		printf("	-slots X: number of streamed panels in flight (default 3)\n");
+		printf("	-multi X,Y,...: split the transposition of a host matrix in bands across the listed devices, and report the scaling efficiency for 1 to all of them. A device can be listed several times\n");
+		printf("	-jobs X: run X independent transposes of the selected size (small sizes, such as -size 256, show the effect best) one after another and through the scheduler on 1 to all compute queues\n");
+		printf("	-verify: run every kernel variant (2D shaders and tile configurations, dynamic shapes, transfer, in-place, permutation, CPU) on a set of shapes and check the results on the host. Checks all data types unless -dtype is given, works on software implementations\n");
+		printf("	-cpu: transpose on the CPU with cache-blocked SIMD kernels on 1, 2, 4, ... up to all cores and report the bandwidth per core count. Also used when no Vulkan device is available\n");
+		printf("	-zerocopy: transpose a host matrix into a host matrix with imported host memory or host-visible device-local memory and through the staging ring, and compare their latency\n");
+		printf("	-shapes X: transpose X distinct shapes with a pipeline specialized for each of them, with one dynamic-shape pipeline and through the plan cache\n");
+		printf("	-autotune: sweep tile configurations for the selected size and data type and save the fastest one to the tuning database. Later runs without -tile, -rows and -vec use it\n");
+		printf("	-tuning X: path to the tuning database (default VulkanTransposition.tuning)\n");
+		printf("	-pipelinecache X: path to the pipeline cache file (default VulkanTransposition.pipelinecache)\n");
+		printf("	-nopipelinecache: do not load or save the pipeline cache file\n");
+		return 0;
+	}
+	if (findFlag(argv, argc, "-devices")>0)
+	{
+		//print device list
+		devices_list();
+		return 0;
 	}
 	if (findFlag(argv, argc, "-d")>0)
 	{
@@ -887,22 +1822,326 @@ int main(int argc, char* argv[])
 		//select the square array size for transposition 
 		char* value = argv[findFlag(argv, argc, "-size") + 1];
 		if (findFlag(argv, argc, "-size") + 1 != argc) {
-			int res = sscanf(value, "%d", &size);
-			if (size < coalescedMemory) {
-				printf("Array size should be bigger than coalescedMemory constant\n");
-				return 1;
-			}
-			if (res == 0) {
+			int res = sscanf(value, "%d", &sizeX);
+			if ((res == 0) || (sizeX == 0)) {
 				printf("No array size is selected with -size flag\n");
 				return 1;
 			}
+			sizeY = sizeX;
 		}
 		else {
 			printf("No array size is selected with -size flag\n");
 			return 1;
 		}
 	}
-	VkResult res = VulkanTest(device_id, coalescedMemory, size);
+	if (findFlag(argv, argc, "-sizeX") > 0)
+	{
+		//select the number of columns of the array
+		char* value = argv[findFlag(argv, argc, "-sizeX") + 1];
+		if (findFlag(argv, argc, "-sizeX") + 1 != argc) {
+			int res = sscanf(value, "%d", &sizeX);
+			if ((res == 0) || (sizeX == 0)) {
+				printf("No number of columns is selected with -sizeX flag\n");
+				return 1;
+			}
+		}
+		else {
+			printf("No number of columns is selected with -sizeX flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-sizeY") > 0)
+	{
+		//select the number of rows of the array
+		char* value = argv[findFlag(argv, argc, "-sizeY") + 1];
+		if (findFlag(argv, argc, "-sizeY") + 1 != argc) {
+			int res = sscanf(value, "%d", &sizeY);
+			if ((res == 0) || (sizeY == 0)) {
+				printf("No number of rows is selected with -sizeY flag\n");
+				return 1;
+			}
+		}
+		else {
+			printf("No number of rows is selected with -sizeY flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-tile") > 0)
+	{
+		//select the tile edge of the 2D shaders
+		char* value = argv[findFlag(argv, argc, "-tile") + 1];
+		if (findFlag(argv, argc, "-tile") + 1 != argc) {
+			int res = sscanf(value, "%d", &tileDim);
+			if ((res == 0) || (tileDim == 0)) {
+				printf("No tile size is selected with -tile flag\n");
+				return 1;
+			}
+		}
+		else {
+			printf("No tile size is selected with -tile flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-rows") > 0)
+	{
+		//select the number of thread rows of the 2D shaders
+		char* value = argv[findFlag(argv, argc, "-rows") + 1];
+		if (findFlag(argv, argc, "-rows") + 1 != argc) {
+			int res = sscanf(value, "%d", &blockRows);
+			if ((res == 0) || (blockRows == 0)) {
+				printf("No number of thread rows is selected with -rows flag\n");
+				return 1;
+			}
+		}
+		else {
+			printf("No number of thread rows is selected with -rows flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-vec") > 0)
+	{
+		//select the vector width of the 2D shaders
+		char* value = argv[findFlag(argv, argc, "-vec") + 1];
+		if (findFlag(argv, argc, "-vec") + 1 != argc) {
+			int res = sscanf(value, "%d", &vectorWidth);
+			if ((res == 0) || ((vectorWidth != 1) && (vectorWidth != 2) && (vectorWidth != 4))) {
+				printf("Vector width selected with -vec flag should be 1, 2 or 4\n");
+				return 1;
+			}
+		}
+		else {
+			printf("Vector width selected with -vec flag should be 1, 2 or 4\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-order") > 0)
+	{
+		//select the workgroup to tile mapping of the 2D transposition
+		const char* value = (findFlag(argv, argc, "-order") + 1 != argc) ? argv[findFlag(argv, argc, "-order") + 1] : "";
+		tileOrder = 3;
+		for (uint32_t i = 0; i < 3; i++) {
+			if (strcmp(value, tileOrderNames[i]) == 0) tileOrder = i;
+		}
+		if (tileOrder == 3) {
+			printf("Tile order selected with -order flag should be linear, diagonal or swizzled\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-tuning") > 0)
+	{
+		//select the tuning database
+		if (findFlag(argv, argc, "-tuning") + 1 != argc) {
+			tuningPath = argv[findFlag(argv, argc, "-tuning") + 1];
+		}
+		else {
+			printf("No tuning database is selected with -tuning flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-pipelinecache") > 0)
+	{
+		//select the pipeline cache file
+		if (findFlag(argv, argc, "-pipelinecache") + 1 != argc) {
+			pipelineCachePath = argv[findFlag(argv, argc, "-pipelinecache") + 1];
+		}
+		else {
+			printf("No pipeline cache file is selected with -pipelinecache flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-nopipelinecache") > 0)
+	{
+		//keep the pipeline cache in memory only
+		pipelineCachePath = NULL;
+	}
+	if (findFlag(argv, argc, "-stream") > 0)
+	{
+		//streaming mode
+		stream = 1;
+	}
+	if (findFlag(argv, argc, "-multi") > 0)
+	{
+		//select the devices of the multi-GPU split
+		if (findFlag(argv, argc, "-multi") + 1 != argc)
+			numMultiDevices = parseList(argv[findFlag(argv, argc, "-multi") + 1], multiDevices, 16);
+		if (numMultiDevices == 0) {
+			printf("No devices are selected with -multi flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-jobs") > 0)
+	{
+		//select the number of jobs in the multi-queue benchmark
+		char* value = argv[findFlag(argv, argc, "-jobs") + 1];
+		if (findFlag(argv, argc, "-jobs") + 1 != argc) {
+			int res = sscanf(value, "%d", &numJobs);
+			if ((res == 0) || (numJobs == 0)) {
+				printf("No number of jobs is selected with -jobs flag\n");
+				return 1;
+			}
+		}
+		else {
+			printf("No number of jobs is selected with -jobs flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-verify") > 0)
+	{
+		//verification mode, all data types by default
+		verify = 1;
+		if (findFlag(argv, argc, "-dtype") == 0) allDataTypes = 1;
+	}
+	if (findFlag(argv, argc, "-cpu") > 0)
+	{
+		//CPU transposition mode
+		cpu = 1;
+	}
+	if (findFlag(argv, argc, "-zerocopy") > 0)
+	{
+		//zero-copy latency mode
+		zeroCopy = 1;
+	}
+	if (findFlag(argv, argc, "-panel") > 0)
+	{
+		//select the number of rows in a streamed panel
+		char* value = argv[findFlag(argv, argc, "-panel") + 1];
+		if (findFlag(argv, argc, "-panel") + 1 != argc) {
+			int res = sscanf(value, "%d", &panelRows);
+			if ((res == 0) || (panelRows == 0)) {
+				printf("No number of panel rows is selected with -panel flag\n");
+				return 1;
+			}
+		}
+		else {
+			printf("No number of panel rows is selected with -panel flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-slots") > 0)
+	{
+		//select the number of streamed panels in flight
+		char* value = argv[findFlag(argv, argc, "-slots") + 1];
+		if (findFlag(argv, argc, "-slots") + 1 != argc) {
+			int res = sscanf(value, "%d", &numSlots);
+			if ((res == 0) || (numSlots == 0)) {
+				printf("No number of slots is selected with -slots flag\n");
+				return 1;
+			}
+		}
+		else {
+			printf("No number of slots is selected with -slots flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-shapes") > 0)
+	{
+		//select the number of shapes in the dynamic-shape benchmark
+		char* value = argv[findFlag(argv, argc, "-shapes") + 1];
+		if (findFlag(argv, argc, "-shapes") + 1 != argc) {
+			int res = sscanf(value, "%d", &numShapes);
+			if ((res == 0) || (numShapes == 0) || (numShapes > 1024)) {
+				printf("Number of shapes selected with -shapes flag should be 1-1024\n");
+				return 1;
+			}
+		}
+		else {
+			printf("Number of shapes selected with -shapes flag should be 1-1024\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-autotune") > 0)
+	{
+		//autotuning mode
+		autotune = 1;
+	}
+	if (findFlag(argv, argc, "-dtype") > 0)
+	{
+		//select the element type
+		dataType = VK_APP_NUM_DATA_TYPES;
+		if (findFlag(argv, argc, "-dtype") + 1 != argc) {
+			char* value = argv[findFlag(argv, argc, "-dtype") + 1];
+			if (strcmp(value, "all") == 0) {
+				allDataTypes = 1;
+				dataType = 0;
+			}
+			for (uint32_t i = 0; i < VK_APP_NUM_DATA_TYPES; i++) {
+				if (strcmp(value, dataTypes[i].name) == 0) dataType = i;
+			}
+		}
+		if (dataType == VK_APP_NUM_DATA_TYPES) {
+			printf("No supported data type is selected with -dtype flag\n");
+			return 1;
+		}
+	}
+	if (findFlag(argv, argc, "-shape") > 0)
+	{
+		//select the tensor shape for permutation
+		if (findFlag(argv, argc, "-shape") + 1 != argc)
+			numAxes = parseList(argv[findFlag(argv, argc, "-shape") + 1], shape, VK_APP_MAX_AXES);
+		if (numAxes == 0) {
+			printf("No tensor shape is selected with -shape flag\n");
+			return 1;
+		}
+		for (uint32_t i = 0; i < numAxes; i++) {
+			if (shape[i] == 0) {
+				printf("Tensor axes should be non-empty\n");
+				return 1;
+			}
+			permutation[i] = numAxes - 1 - i;
+		}
+		if (findFlag(argv, argc, "-permutation") > 0)
+		{
+			//select the order of the output axes
+			uint32_t numPermutedAxes = 0;
+			if (findFlag(argv, argc, "-permutation") + 1 != argc)
+				numPermutedAxes = parseList(argv[findFlag(argv, argc, "-permutation") + 1], permutation, VK_APP_MAX_AXES);
+			uint32_t usedAxes = 0;
+			for (uint32_t i = 0; i < numPermutedAxes; i++) {
+				if (permutation[i] < numAxes) usedAxes |= 1 << permutation[i];
+			}
+			if ((numPermutedAxes != numAxes) || (usedAxes != (1u << numAxes) - 1)) {
+				printf("Permutation selected with -permutation flag should list every axis of the tensor once\n");
+				return 1;
+			}
+		}
+	}
+	if (findFlag(argv, argc, "-inplace") > 0)
+	{
+		//in-place transposition mode
+		inPlace = 1;
+	}
+	VkResult res = VK_SUCCESS;
+	for (uint32_t i = 0; i < VK_APP_NUM_DATA_TYPES; i++) {
+		if ((!allDataTypes) && (i != dataType)) continue;
+		if (verify)
+			res = VulkanVerifyTest(device_id, coalescedMemory, sizeX, sizeY, i, pipelineCachePath);
+		else if (cpu)
+			res = VulkanCPUTest(sizeX, sizeY, i);
+		else if (autotune)
+			res = VulkanAutotune(device_id, sizeX, sizeY, i, tuningPath, pipelineCachePath);
+		else if (stream)
+			res = VulkanStreamTest(device_id, coalescedMemory, sizeX, sizeY, i, panelRows, numSlots, pipelineCachePath);
+		else if (numMultiDevices > 0)
+			res = VulkanMultiGPUTest(numMultiDevices, multiDevices, coalescedMemory, sizeX, sizeY, i, pipelineCachePath);
+		else if (numJobs > 0)
+			res = VulkanQueuesTest(device_id, coalescedMemory, numJobs, sizeX, sizeY, i, pipelineCachePath);
+		else if (zeroCopy)
+			res = VulkanZeroCopyTest(device_id, coalescedMemory, sizeX, sizeY, i, pipelineCachePath);
+		else if (numShapes > 0)
+			res = VulkanShapesTest(device_id, coalescedMemory, numShapes, i, pipelineCachePath);
+		else if (numAxes > 0)
+			res = VulkanPermutationTest(device_id, coalescedMemory, numAxes, shape, permutation, i, pipelineCachePath);
+		else if (inPlace)
+			res = VulkanInPlaceTest(device_id, coalescedMemory, sizeX, sizeY, i, pipelineCachePath);
+		else
+			res = VulkanTest(device_id, coalescedMemory, sizeX, sizeY, i, tileDim, blockRows, vectorWidth, tileOrder, tuningPath, pipelineCachePath);
+		//types that are not supported by the device are skipped, if all types are tested
+		if ((res == VK_ERROR_FEATURE_NOT_PRESENT) && (allDataTypes)) {
+			res = VK_SUCCESS;
+			continue;
+		}
+		if (res != VK_SUCCESS) return res;
+	}
 	return res;
 }
 #ifdef __cplusplus
@@ -0,0 +1,413 @@
+﻿#ifdef __cplusplus
+extern "C" {
+#endif
+#include "VkTransposition.h"
+
+//one line of the results: a kernel variant on one shape and data type
+typedef struct {
+	const char* variant;
+	uint32_t dataType;
+	uint32_t size[2];
+	uint32_t tileDim;
+	uint32_t blockRows;
+	uint32_t vectorWidth;
+	uint32_t tileOrder;
+	uint32_t trials;
+	//statistics of the per-trial median dispatch time (in ms): mean, half-width of its 95% confidence interval, min and max
+	double mean;
+	double ci95;
+	double min;
+	double max;
+	//bandwidth (read + write) at the mean time and its 95% confidence interval, percentage of the transfer.comp copy rate of the same shape, negative if there is no reference
+	double bandwidth;
+	double bandwidthCI95;
+	double roofline;
+	//bandwidth as a percentage of the best copy probe and as a multiple of the worst strided probe on the same buffers, negative if the probes did not run (GPU variants only)
+	double bestCopy;
+	double worstStrided;
+	uint32_t gpuTimestamps;
+} VkAppBenchmarkResult;
+typedef struct {
+	uint32_t numResults;
+	uint32_t maxResults;
+	VkAppBenchmarkResult* results;
+} VkAppBenchmarkResults;
+//kernel variants of the sweep: backend, out-of-place shaderID (3 - two-axis permutation, 7 - subgroup shuffles), tile configuration of the 2D shaders (0 - default) and their workgroup to tile mapping
+typedef struct {
+	const char* name;
+	//0 - out-of-place shaderID, 1 - in-place transposition (shaderID 4 or 5 depending on the shape), 2 - CPU transposition
+	uint32_t mode;
+	uint32_t shaderID;
+	uint32_t tileDim;
+	uint32_t blockRows;
+	uint32_t vectorWidth;
+	uint32_t tileOrder;
+} VkAppBenchmarkVariant;
+//names of the VK_APP_TILE_ORDER_* mappings in the results
+const char* tileOrderNames[3] = { "linear", "diagonal", "swizzled" };
+
+double studentT95(uint32_t degreesOfFreedom) {
+	//two-sided 95% quantile of the Student's t-distribution, the normal quantile above 30 degrees of freedom
+	const double t[30] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+	if (degreesOfFreedom == 0) return 0;
+	return (degreesOfFreedom <= 30) ? t[degreesOfFreedom - 1] : 1.960;
+}
+void computeStatistics(double* times, uint32_t trials, VkAppBenchmarkResult* result) {
+	//mean, 95% confidence interval of the mean, min and max of the trial times
+	double sum = 0;
+	result->min = times[0];
+	result->max = times[0];
+	for (uint32_t i = 0; i < trials; i++) {
+		sum += times[i];
+		if (times[i] < result->min) result->min = times[i];
+		if (times[i] > result->max) result->max = times[i];
+	}
+	result->mean = sum / trials;
+	double variance = 0;
+	for (uint32_t i = 0; i < trials; i++)
+		variance += (times[i] - result->mean) * (times[i] - result->mean);
+	variance = (trials > 1) ? variance / (trials - 1) : 0;
+	result->ci95 = studentT95(trials - 1) * sqrt(variance / trials);
+	result->trials = trials;
+}
+VkAppBenchmarkResult* addResult(VkAppBenchmarkResults* results) {
+	//append a zeroed result, growing the array if needed
+	if (results->numResults == results->maxResults) {
+		uint32_t maxResults = (results->maxResults) ? 2 * results->maxResults : 256;
+		VkAppBenchmarkResult* newResults = (VkAppBenchmarkResult*)realloc(results->results, maxResults * sizeof(VkAppBenchmarkResult));
+		if (newResults == NULL) return NULL;
+		results->results = newResults;
+		results->maxResults = maxResults;
+	}
+	VkAppBenchmarkResult* result = &results->results[results->numResults++];
+	memset(result, 0, sizeof(VkAppBenchmarkResult));
+	return result;
+}
+VkResult benchmarkApp(VkGPU* vkGPU, VkApplication* app, uint32_t warmup, uint32_t trials, uint32_t batch, VkAppBenchmarkResult* result) {
+	//warm-up runs are not recorded, each trial is one runApp call of batch dispatches and contributes its median dispatch time
+	VkResult res = VK_SUCCESS;
+	VkAppTimings timings = { 0 };
+	for (uint32_t i = 0; i < warmup; i++) {
+		res = runApp(vkGPU, app, batch, &timings);
+		if (res != VK_SUCCESS) return res;
+	}
+	double* times = (double*)malloc(trials * sizeof(double));
+	if (times == NULL) return VK_ERROR_OUT_OF_HOST_MEMORY;
+	for (uint32_t i = 0; i < trials; i++) {
+		res = runApp(vkGPU, app, batch, &timings);
+		if (res != VK_SUCCESS) {
+			free(times);
+			return res;
+		}
+		times[i] = timings.median;
+	}
+	computeStatistics(times, trials, result);
+	result->gpuTimestamps = timings.gpuTimestamps;
+	free(times);
+	return res;
+}
+VkResult benchmarkCPU(VkApplication* app, void* input, void* output, uint32_t warmup, uint32_t trials, VkAppBenchmarkResult* result) {
+	//CPU transposition on all cores, timed with the host wall clock
+	VkResult res = VK_SUCCESS;
+	double* times = (double*)malloc(trials * sizeof(double));
+	if (times == NULL) return VK_ERROR_OUT_OF_HOST_MEMORY;
+	for (uint32_t i = 0; i < warmup + trials; i++) {
+		double start = getWallTime();
+		res = cpuApp(app, input, output, 0);
+		if (res != VK_SUCCESS) {
+			free(times);
+			return res;
+		}
+		if (i >= warmup) times[i - warmup] = getWallTime() - start;
+	}
+	computeStatistics(times, trials, result);
+	free(times);
+	return res;
+}
+VkResult writeResults(VkGPU* vkGPU, VkAppBenchmarkResults* results, const char* csvPath, const char* jsonPath) {
+	//CSV: one line per result with the device columns repeated, so files of several runs can be concatenated. JSON: device object and the array of results
+	const char* deviceName = vkGPU->physicalDeviceProperties.deviceName;
+	uint32_t vendorID = vkGPU->physicalDeviceProperties.vendorID;
+	uint32_t deviceID = vkGPU->physicalDeviceProperties.deviceID;
+	uint32_t driverVersion = vkGPU->physicalDeviceProperties.driverVersion;
+	if (csvPath != NULL) {
+		FILE* fp = fopen(csvPath, "w");
+		if (fp == NULL) return VK_ERROR_INITIALIZATION_FAILED;
+		fprintf(fp, "device,vendor_id,device_id,driver_version,dtype,size_x,size_y,variant,tile,rows,vector,order,trials,timer,mean_ms,ci95_ms,min_ms,max_ms,gbps,gbps_ci95,roofline_percent,best_copy_percent,worst_strided_ratio\n");
+		for (uint32_t i = 0; i < results->numResults; i++) {
+			VkAppBenchmarkResult* result = &results->results[i];
+			fprintf(fp, "\"%s\",%x,%x,%x,%s,%u,%u,%s,%u,%u,%u,%s,%u,%s,%.6f,%.6f,%.6f,%.6f,%.3f,%.3f,", deviceName, vendorID, deviceID, driverVersion, dataTypes[result->dataType].name, result->size[0], result->size[1], result->variant, result->tileDim, result->blockRows, result->vectorWidth, tileOrderNames[result->tileOrder], result->trials, (result->gpuTimestamps) ? "gpu" : "host", result->mean, result->ci95, result->min, result->max, result->bandwidth, result->bandwidthCI95);
+			if (result->roofline >= 0) fprintf(fp, "%.2f", result->roofline);
+			fprintf(fp, ",");
+			if (result->bestCopy >= 0) fprintf(fp, "%.2f,%.3f", result->bestCopy, result->worstStrided);
+			else fprintf(fp, ",");
+			fprintf(fp, "\n");
+		}
+		fclose(fp);
+	}
+	if (jsonPath != NULL) {
+		FILE* fp = fopen(jsonPath, "w");
+		if (fp == NULL) return VK_ERROR_INITIALIZATION_FAILED;
+		fprintf(fp, "{\n\t\"device\": { \"name\": \"%s\", \"vendor_id\": %u, \"device_id\": %u, \"driver_version\": %u },\n\t\"results\": [\n", deviceName, vendorID, deviceID, driverVersion);
+		for (uint32_t i = 0; i < results->numResults; i++) {
+			VkAppBenchmarkResult* result = &results->results[i];
+			fprintf(fp, "\t\t{ \"dtype\": \"%s\", \"size_x\": %u, \"size_y\": %u, \"variant\": \"%s\", \"tile\": %u, \"rows\": %u, \"vector\": %u, \"order\": \"%s\", \"trials\": %u, \"timer\": \"%s\", \"mean_ms\": %.6f, \"ci95_ms\": %.6f, \"min_ms\": %.6f, \"max_ms\": %.6f, \"gbps\": %.3f, \"gbps_ci95\": %.3f, ", dataTypes[result->dataType].name, result->size[0], result->size[1], result->variant, result->tileDim, result->blockRows, result->vectorWidth, tileOrderNames[result->tileOrder], result->trials, (result->gpuTimestamps) ? "gpu" : "host", result->mean, result->ci95, result->min, result->max, result->bandwidth, result->bandwidthCI95);
+			if (result->roofline >= 0)
+				fprintf(fp, "\"roofline_percent\": %.2f, ", result->roofline);
+			else
+				fprintf(fp, "\"roofline_percent\": null, ");
+			if (result->bestCopy >= 0)
+				fprintf(fp, "\"best_copy_percent\": %.2f, \"worst_strided_ratio\": %.3f }%s\n", result->bestCopy, result->worstStrided, (i + 1 < results->numResults) ? "," : "");
+			else
+				fprintf(fp, "\"best_copy_percent\": null, \"worst_strided_ratio\": null }%s\n", (i + 1 < results->numResults) ? "," : "");
+		}
+		fprintf(fp, "\t]\n}\n");
+		fclose(fp);
+	}
+	return VK_SUCCESS;
+}
+VkResult benchmarkShape(VkGPU* vkGPU, uint32_t coalescedMemory, uint32_t sizeX, uint32_t sizeY, uint32_t dataType, uint32_t warmup, uint32_t trials, VkAppBenchmarkResults* results)
+{
+	//run all variants on one shape and data type. transfer.comp is measured first, it is the copy roofline of the other variants
+	const VkAppBenchmarkVariant variants[] = {
+		{ "transfer", 0, 2, 0, 0, 0, 0 },
+		{ "padded", 0, 0, 0, 0, 0, VK_APP_TILE_ORDER_LINEAR },
+		{ "padded", 0, 0, 0, 0, 0, VK_APP_TILE_ORDER_DIAGONAL },
+		{ "padded", 0, 0, 0, 0, 0, VK_APP_TILE_ORDER_SWIZZLED },
+		{ "padded", 0, 0, 16, 4, 1, 0 },
+		{ "padded", 0, 0, 32, 8, 1, 0 },
+		{ "padded", 0, 0, 64, 8, 1, 0 },
+		{ "padded", 0, 0, 32, 8, 4, 0 },
+		{ "unpadded", 0, 1, 0, 0, 0, VK_APP_TILE_ORDER_LINEAR },
+		{ "unpadded", 0, 1, 0, 0, 0, VK_APP_TILE_ORDER_DIAGONAL },
+		{ "unpadded", 0, 1, 32, 8, 1, 0 },
+		{ "subgroup", 0, 7, 0, 0, 0, 0 },
+		{ "permutation", 0, 3, 0, 0, 0, 0 },
+		{ "in-place", 1, 4, 0, 0, 0, 0 },
+		{ "cpu", 2, 0, 0, 0, 0, 0 },
+	};
+	VkResult res = VK_SUCCESS;
+	uint32_t elementSize = dataTypes[dataType].size;
+	uint64_t numElements = (uint64_t)sizeX * sizeY;
+	//the output buffer is also the scratch buffer of the rectangular in-place transposition
+	uint64_t scratchElements = 64 * (uint64_t)((sizeX > sizeY) ? sizeX : sizeY);
+	VkDeviceSize inputBufferSize = elementSize * numElements;
+	VkDeviceSize outputBufferSize = elementSize * ((numElements > scratchElements) ? numElements : scratchElements);
+	VkBuffer inputBuffer = { 0 };
+	VkDeviceMemory inputBufferDeviceMemory = { 0 };
+	VkBuffer outputBuffer = { 0 };
+	VkDeviceMemory outputBufferDeviceMemory = { 0 };
+	res = allocateFFTBuffer(vkGPU, &inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, inputBufferSize);
+	if (res != VK_SUCCESS) return res;
+	res = allocateFFTBuffer(vkGPU, &outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, outputBufferSize);
+	if (res != VK_SUCCESS) {
+		freeFFTBuffer(vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+		return res;
+	}
+	//dispatches per trial: enough to move about 256 MB, so small shapes are not dominated by the submit latency
+	uint32_t batch = (uint32_t)((256ull * 1024 * 1024) / inputBufferSize);
+	if (batch < 4) batch = 4;
+	if (batch > 1000) batch = 1000;
+	void* input = NULL;
+	void* output = NULL;
+	double rooflineTime = 0;
+	//time of the default padded variant, the subgroup shuffle transposition is compared to it
+	double paddedTime = 0;
+	//bandwidth probes on the same buffers bound the variants from above (best copy) and below (worst strided access). Shapes under 16 KB are too small for the probes
+	VkAppBandwidth bandwidth = { 0 };
+	if (measureBandwidth(vkGPU, &inputBuffer, &outputBuffer, inputBufferSize, batch, &bandwidth) != VK_SUCCESS) bandwidth.bestCopy = 0;
+	for (uint32_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+		VkApplication app = { 0 };
+		app.size[0] = sizeX;
+		app.size[1] = sizeY;
+		app.size[2] = 1;
+		app.dataType = dataType;
+		app.coalescedMemory = coalescedMemory;
+		app.tileDim = variants[v].tileDim;
+		app.blockRows = variants[v].blockRows;
+		app.vectorWidth = variants[v].vectorWidth;
+		app.tileOrder = variants[v].tileOrder;
+		VkAppBenchmarkResult result = { 0 };
+		result.variant = variants[v].name;
+		result.dataType = dataType;
+		result.size[0] = sizeX;
+		result.size[1] = sizeY;
+		if (variants[v].mode == 2) {
+			//host matrices are only allocated for the CPU variant
+			input = malloc(inputBufferSize);
+			output = malloc(inputBufferSize);
+			if ((input == NULL) || (output == NULL)) {
+				free(input);
+				free(output);
+				continue;
+			}
+			memset(input, 0, inputBufferSize);
+			res = benchmarkCPU(&app, input, output, warmup, trials, &result);
+			free(input);
+			free(output);
+		}
+		else {
+			uint32_t shaderID = variants[v].shaderID;
+			app.inputBufferSize = inputBufferSize;
+			app.inputBuffer = &inputBuffer;
+			app.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+			app.outputBufferSize = outputBufferSize;
+			app.outputBuffer = &outputBuffer;
+			app.outputBufferDeviceMemory = &outputBufferDeviceMemory;
+			if (shaderID == 3) {
+				//the transposition as a permutation of two axes
+				app.size[0] = 1;
+				app.size[1] = 1;
+				app.numAxes = 2;
+				app.axes[0] = sizeX;
+				app.axes[1] = sizeY;
+				app.permutation[0] = 1;
+				app.permutation[1] = 0;
+			}
+			if (variants[v].mode == 1) {
+				//square matrices swap tile pairs in the input buffer, rectangular ones use the output buffer as scratch
+				shaderID = (sizeX == sizeY) ? 4 : 5;
+				if (shaderID == 4) {
+					app.outputBufferSize = inputBufferSize;
+					app.outputBuffer = &inputBuffer;
+					app.outputBufferDeviceMemory = &inputBufferDeviceMemory;
+				}
+				else
+					app.scratchLines = 64;
+			}
+			res = createApp(vkGPU, &app, shaderID);
+			//configurations that exceed device limits or were adjusted by createApp are skipped, they are covered by other entries
+			if ((res != VK_SUCCESS) || ((variants[v].tileDim) && ((app.tileDim != variants[v].tileDim) || (app.blockRows != variants[v].blockRows) || (app.vectorWidth != variants[v].vectorWidth)))) {
+				deleteApp(vkGPU, &app);
+				if ((res == VK_ERROR_FEATURE_NOT_PRESENT) && (shaderID != 7)) break;
+				res = VK_SUCCESS;
+				continue;
+			}
+			result.tileDim = app.tileDim;
+			result.blockRows = app.blockRows;
+			result.vectorWidth = app.vectorWidth;
+			result.tileOrder = app.tileOrder;
+			//the rectangular in-place transposition runs several passes per dispatch, so it gets fewer dispatches
+			res = benchmarkApp(vkGPU, &app, warmup, trials, (shaderID == 5) ? 4 : batch, &result);
+			deleteApp(vkGPU, &app);
+		}
+		if (res != VK_SUCCESS) break;
+		if ((variants[v].mode == 0) && (variants[v].shaderID == 2)) rooflineTime = result.mean;
+		if ((variants[v].mode == 0) && (variants[v].shaderID == 0) && (variants[v].tileDim == 0) && (variants[v].tileOrder == VK_APP_TILE_ORDER_LINEAR)) paddedTime = result.mean;
+		result.bandwidth = 2 * inputBufferSize / 1024.0 / 1024.0 / 1024.0 / result.mean * 1000;
+		result.bandwidthCI95 = (result.mean > result.ci95) ? result.bandwidth * result.ci95 / (result.mean - result.ci95) : 0;
+		result.roofline = ((variants[v].mode != 2) && (rooflineTime > 0)) ? rooflineTime / result.mean * 100 : -1;
+		result.bestCopy = ((variants[v].mode != 2) && (bandwidth.bestCopy > 0)) ? result.bandwidth / bandwidth.bestCopy * 100 : -1;
+		result.worstStrided = (result.bestCopy >= 0) ? result.bandwidth / bandwidth.worstStrided : -1;
+		VkAppBenchmarkResult* stored = addResult(results);
+		if (stored == NULL) {
+			res = VK_ERROR_OUT_OF_HOST_MEMORY;
+			break;
+		}
+		stored[0] = result;
+		printf("%-12s %5dx%-5d %-11s tile %3d rows %2d vec %d %-8s: %9.4f ms +- %7.4f, %7.2f GB/s", dataTypes[dataType].name, sizeX, sizeY, result.variant, result.tileDim, result.blockRows, result.vectorWidth, tileOrderNames[result.tileOrder], result.mean, result.ci95, result.bandwidth);
+		if (result.roofline >= 0) printf(", %5.1f%% of copy", result.roofline);
+		if (result.bestCopy >= 0) printf(", %5.1f%% of best copy probe, %5.2fx worst strided", result.bestCopy, result.worstStrided);
+		if ((variants[v].mode == 0) && (variants[v].shaderID == 7) && (paddedTime > 0)) printf(", %.2fx padded", paddedTime / result.mean);
+		printf("\n");
+	}
+	freeFFTBuffer(vkGPU, &inputBuffer, &inputBufferDeviceMemory);
+	freeFFTBuffer(vkGPU, &outputBuffer, &outputBufferDeviceMemory);
+	return res;
+}
+int findFlag(char** argv, int num, char* flag) {
+	//search for the flag in argv. Flags are matched exactly
+	for (int i = 0; i < num; i++) {
+		if (strcmp(argv[i], flag) == 0) return i;
+	}
+	return 0;
+}
+uint32_t findValue(int argc, char** argv, char* flag, uint32_t defaultValue) {
+	//unsigned value after the flag, the default value if the flag is not given or has no valid value
+	int i = findFlag(argv, argc, flag);
+	uint32_t value = 0;
+	if ((i > 0) && (i + 1 < argc) && (sscanf(argv[i + 1], "%u", &value) == 1) && (value > 0)) return value;
+	return defaultValue;
+}
+int main(int argc, char* argv[])
+{
+	//sweep matrix sizes from cache-resident to memory-bound, aspect ratios, data types, tile configurations and kernel variants. Results are printed and optionally written as CSV and JSON
+	if (findFlag(argv, argc, "-h") > 0) {
+		printf("Vulkan Compute transposition benchmark\n");
+		printf("	-h: print help\n");
+		printf("	-d X: select GPU device (default 0)\n");
+		printf("	-c X: specify how much memory is coalesced per transfer (default: vendor default)\n");
+		printf("	-dtype X: element type: fp32, fp16, fp64, int8, complex_fp32, complex_fp64 or all (default all)\n");
+		printf("	-minsize X: edge of the smallest square matrix of the sweep (default 256)\n");
+		printf("	-maxsize X: edge of the largest square matrix of the sweep, sizes double in between (default 4096)\n");
+		printf("	-maxmemory X: largest matrix in MB, larger shapes of the sweep are skipped (default 256)\n");
+		printf("	-warmup X: number of warm-up runs of each variant (default 3)\n");
+		printf("	-trials X: number of measured runs of each variant, the confidence intervals are computed over them (default 10)\n");
+		printf("	-csv X: write the results to the CSV file X\n");
+		printf("	-json X: write the results to the JSON file X\n");
+		printf("	-pipelinecache X: path to the pipeline cache file (default VulkanTransposition.pipelinecache)\n");
+		return 0;
+	}
+	VkGPU vkGPU = { 0 };
+	vkGPU.device_id = findValue(argc, argv, "-d", 0);
+	vkGPU.pipelineCachePath = "VulkanTransposition.pipelinecache";
+	if ((findFlag(argv, argc, "-pipelinecache") > 0) && (findFlag(argv, argc, "-pipelinecache") + 1 < argc))
+		vkGPU.pipelineCachePath = argv[findFlag(argv, argc, "-pipelinecache") + 1];
+	uint32_t coalescedMemory = findValue(argc, argv, "-c", 0);
+	uint32_t minSize = findValue(argc, argv, "-minsize", 256);
+	uint32_t maxSize = findValue(argc, argv, "-maxsize", 4096);
+	uint64_t maxMemory = (uint64_t)findValue(argc, argv, "-maxmemory", 256) * 1024 * 1024;
+	uint32_t warmup = findValue(argc, argv, "-warmup", 3);
+	uint32_t trials = findValue(argc, argv, "-trials", 10);
+	const char* csvPath = ((findFlag(argv, argc, "-csv") > 0) && (findFlag(argv, argc, "-csv") + 1 < argc)) ? argv[findFlag(argv, argc, "-csv") + 1] : NULL;
+	const char* jsonPath = ((findFlag(argv, argc, "-json") > 0) && (findFlag(argv, argc, "-json") + 1 < argc)) ? argv[findFlag(argv, argc, "-json") + 1] : NULL;
+	//VK_APP_NUM_DATA_TYPES - all data types
+	uint32_t dataType = VK_APP_NUM_DATA_TYPES;
+	if (findFlag(argv, argc, "-dtype") > 0) {
+		const char* value = (findFlag(argv, argc, "-dtype") + 1 < argc) ? argv[findFlag(argv, argc, "-dtype") + 1] : "";
+		for (uint32_t i = 0; i < VK_APP_NUM_DATA_TYPES; i++) {
+			if (strcmp(value, dataTypes[i].name) == 0) dataType = i;
+		}
+		if ((dataType == VK_APP_NUM_DATA_TYPES) && (strcmp(value, "all") != 0)) {
+			printf("No supported data type is selected with -dtype flag\n");
+			return 1;
+		}
+	}
+	VkResult res = createGPU(&vkGPU);
+	if (res != VK_SUCCESS) return res;
+	if (coalescedMemory == 0) coalescedMemory = defaultCoalescedMemory(&vkGPU);
+	printf("Device: %s, driver version: %x, timer: %s\n", vkGPU.physicalDeviceProperties.deviceName, vkGPU.physicalDeviceProperties.driverVersion, (vkGPU.timestampValidBits > 0) ? "GPU timestamps" : "host wall clock");
+	printf("Warm-up runs: %d, trials: %d, +- is the 95%% confidence interval of the mean dispatch time\n", warmup, trials);
+	VkAppBenchmarkResults results = { 0 };
+	//aspect ratios of each matrix area: square, 4:1 and 16:1 in both orientations, and a square matrix one element smaller (odd for the default power-of-two sweep), which has no power-of-two strides
+	const uint32_t aspectShifts[][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 2, 0, 0 }, { 0, 2, 0 }, { 0, 0, 1 } };
+	for (uint32_t t = 0; t < VK_APP_NUM_DATA_TYPES; t++) {
+		if ((dataType != VK_APP_NUM_DATA_TYPES) && (t != dataType)) continue;
+		if (((dataTypes[t].size == 1) && (!vkGPU.storage8Bit)) || ((dataTypes[t].size == 2) && (!vkGPU.storage16Bit))) {
+			printf("Data type %s is not supported by the device\n", dataTypes[t].name);
+			continue;
+		}
+		for (uint32_t size = minSize; size <= maxSize; size *= 2) {
+			for (uint32_t a = 0; a < sizeof(aspectShifts) / sizeof(aspectShifts[0]); a++) {
+				uint32_t sizeX = ((size << aspectShifts[a][0]) >> aspectShifts[a][1]) - aspectShifts[a][2];
+				uint32_t sizeY = ((size << aspectShifts[a][1]) >> aspectShifts[a][0]) - aspectShifts[a][2];
+				if ((sizeX == 0) || (sizeY == 0) || ((uint64_t)sizeX * sizeY * dataTypes[t].size > maxMemory)) continue;
+				res = benchmarkShape(&vkGPU, coalescedMemory, sizeX, sizeY, t, warmup, trials, &results);
+				if (res != VK_SUCCESS) {
+					printf("Benchmark of %s %dx%d failed, error code: %d\n", dataTypes[t].name, sizeX, sizeY, res);
+					break;
+				}
+			}
+			if (res != VK_SUCCESS) break;
+		}
+		if (res != VK_SUCCESS) break;
+	}
+	if (writeResults(&vkGPU, &results, csvPath, jsonPath) != VK_SUCCESS)
+		printf("Could not write the results\n");
+	free(results.results);
+	deleteGPU(&vkGPU);
+	return res;
+}
+#ifdef __cplusplus
+}
+#endif